@@ -0,0 +1,214 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+/*
+** Hot loops written once and instantiated for both a raw integer and a strong type wrapping it.
+** Every raw_<name> function must compile to exactly the same instructions as its strong_<name> counterpart,
+** which is verified by cmake/CheckCodegen.cmake.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <st/st.hpp>
+#include <st/quantity.hpp>
+
+using raw_int = std::int64_t;
+
+using strong_int = st::type<
+    std::int64_t,
+    struct strong_int_tag,
+    st::arithmetic,
+    st::bitwise_manipulable,
+    st::hashable
+>;
+
+using meters = st::quantity<double, st::dimensions::length>;
+using milliseconds = st::quantity<double, st::dimensions::time, std::milli>;
+using seconds = st::quantity<double, st::dimensions::time>;
+using km_per_hour = st::quantity<double, st::dimensions::velocity, std::ratio<1000, 3600>>;
+
+namespace
+{
+    template <typename T>
+    T accumulate(const T *p, std::size_t n) noexcept
+    {
+        T acc(0);
+
+        for (std::size_t i = 0; i < n; ++i)
+            acc = acc + p[i];
+        return acc;
+    }
+
+    template <typename T>
+    T accumulate_in_place(const T *p, std::size_t n) noexcept
+    {
+        T acc(0);
+
+        for (std::size_t i = 0; i < n; ++i)
+            acc += p[i];
+        return acc;
+    }
+
+    template <typename T>
+    T product(const T *p, std::size_t n) noexcept
+    {
+        T acc(1);
+
+        for (std::size_t i = 0; i < n; ++i)
+            acc = acc * p[i];
+        return acc;
+    }
+
+    template <typename T>
+    std::size_t count_less(const T *p, std::size_t n, T threshold) noexcept
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < n; ++i)
+            count += p[i] < threshold;
+        return count;
+    }
+
+    template <typename T>
+    std::size_t find_equal(const T *p, std::size_t n, T key) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (p[i] == key)
+                return i;
+        }
+        return n;
+    }
+
+    template <typename T>
+    T minimum(const T *p, std::size_t n) noexcept
+    {
+        T best = p[0];
+
+        for (std::size_t i = 1; i < n; ++i) {
+            if (p[i] < best)
+                best = p[i];
+        }
+        return best;
+    }
+
+    template <typename T>
+    T xor_fold(const T *p, std::size_t n) noexcept
+    {
+        T acc(0);
+
+        for (std::size_t i = 0; i < n; ++i)
+            acc = acc ^ p[i];
+        return acc;
+    }
+
+    template <typename T>
+    T mask_all(const T *p, std::size_t n) noexcept
+    {
+        T acc(~std::int64_t(0));
+
+        for (std::size_t i = 0; i < n; ++i)
+            acc &= ~p[i] | p[i];
+        return acc;
+    }
+
+    template <typename T>
+    T count_up(std::size_t n) noexcept
+    {
+        T counter(0);
+
+        for (std::size_t i = 0; i < n; ++i)
+            ++counter;
+        return counter;
+    }
+
+    template <typename T>
+    std::size_t hash_all(const T *p, std::size_t n) noexcept
+    {
+        std::size_t h = 0;
+
+        for (std::size_t i = 0; i < n; ++i)
+            h ^= std::hash<T>()(p[i]);
+        return h;
+    }
+}
+
+#define STRONG_TYPE_CODEGEN_PAIR(ret, name, params, args)                           \
+    extern "C" ret raw_##name(const raw_int *p, std::size_t n params(raw_int))      \
+    {                                                                               \
+        return static_cast<ret>(st::unwrap(name(p, n args)));                       \
+    }                                                                               \
+                                                                                    \
+    extern "C" ret strong_##name(const strong_int *p, std::size_t n params(strong_int)) \
+    {                                                                               \
+        return static_cast<ret>(st::unwrap(name(p, n args)));                       \
+    }
+
+#define STRONG_TYPE_NO_PARAMS(T)
+#define STRONG_TYPE_NO_ARGS
+#define STRONG_TYPE_VALUE_PARAM(T) , T value
+#define STRONG_TYPE_VALUE_ARG , value
+
+STRONG_TYPE_CODEGEN_PAIR(std::int64_t, accumulate, STRONG_TYPE_NO_PARAMS, STRONG_TYPE_NO_ARGS)
+STRONG_TYPE_CODEGEN_PAIR(std::int64_t, accumulate_in_place, STRONG_TYPE_NO_PARAMS, STRONG_TYPE_NO_ARGS)
+STRONG_TYPE_CODEGEN_PAIR(std::int64_t, product, STRONG_TYPE_NO_PARAMS, STRONG_TYPE_NO_ARGS)
+STRONG_TYPE_CODEGEN_PAIR(std::size_t, count_less, STRONG_TYPE_VALUE_PARAM, STRONG_TYPE_VALUE_ARG)
+STRONG_TYPE_CODEGEN_PAIR(std::size_t, find_equal, STRONG_TYPE_VALUE_PARAM, STRONG_TYPE_VALUE_ARG)
+STRONG_TYPE_CODEGEN_PAIR(std::int64_t, minimum, STRONG_TYPE_NO_PARAMS, STRONG_TYPE_NO_ARGS)
+STRONG_TYPE_CODEGEN_PAIR(std::int64_t, xor_fold, STRONG_TYPE_NO_PARAMS, STRONG_TYPE_NO_ARGS)
+STRONG_TYPE_CODEGEN_PAIR(std::int64_t, mask_all, STRONG_TYPE_NO_PARAMS, STRONG_TYPE_NO_ARGS)
+STRONG_TYPE_CODEGEN_PAIR(std::size_t, hash_all, STRONG_TYPE_NO_PARAMS, STRONG_TYPE_NO_ARGS)
+
+extern "C" std::int64_t raw_count_up(std::size_t n)
+{
+    return st::unwrap(count_up<raw_int>(n));
+}
+
+extern "C" std::int64_t strong_count_up(std::size_t n)
+{
+    return st::unwrap(count_up<strong_int>(n));
+}
+
+/* Same-scale arithmetic on quantities must not scale anything */
+extern "C" double raw_quantity_accumulate(const double *p, std::size_t n)
+{
+    return accumulate(p, n);
+}
+
+extern "C" double strong_quantity_accumulate(const milliseconds *p, std::size_t n)
+{
+    return accumulate(p, n).value();
+}
+
+/* Conversions multiply once by a factor folded at compile time */
+extern "C" void raw_quantity_to_seconds(const double *p, std::size_t n, double *out)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = p[i] * 0.001;
+}
+
+extern "C" void strong_quantity_to_seconds(const milliseconds *p, std::size_t n, seconds *out)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = st::quantity_cast<seconds>(p[i]);
+}
+
+/*
+ * Meters per millisecond to kilometers per hour folds to a single multiplication by 3600
+ *
+ * out does not alias the inputs, otherwise the vectorizer emits its overlap checks in an arbitrary order.
+ */
+extern "C" void raw_quantity_speed(const double *distances, const double *durations, std::size_t n,
+                                   double *__restrict out)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = distances[i] / durations[i] * 3600.0;
+}
+
+extern "C" void strong_quantity_speed(const meters *distances, const milliseconds *durations, std::size_t n,
+                                      km_per_hour *__restrict out)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = st::quantity_cast<km_per_hour>(distances[i] / durations[i]);
+}
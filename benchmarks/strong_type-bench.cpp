@@ -0,0 +1,1271 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <st/st.hpp>
+#include <st/dense_map.hpp>
+#include <st/slot_map.hpp>
+#include <st/interned.hpp>
+#include <st/vector.hpp>
+#include <st/atomic.hpp>
+#include <st/sharded.hpp>
+#include <st/overflow.hpp>
+#include <st/bounded.hpp>
+#include <st/packed_vector.hpp>
+#include <st/lazy.hpp>
+#include <st/algorithm.hpp>
+#include <st/parallel.hpp>
+#include <st/optional.hpp>
+
+using raw_int = std::int64_t;
+
+using strong_int = st::type<
+    std::int64_t,
+    struct strong_int_tag,
+    st::arithmetic,
+    st::bitwise_manipulable,
+    st::hashable
+>;
+
+namespace
+{
+    template <typename T>
+    std::vector<T> make_values(std::size_t n)
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<std::int64_t> dist(-1000000, 1000000);
+        std::vector<T> values;
+
+        values.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            values.emplace_back(dist(rng));
+        return values;
+    }
+}
+
+template <typename T>
+static void bm_accumulate(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        T acc(0);
+        for (const auto &v : values)
+            acc = acc + v;
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_accumulate_in_place(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        T acc(0);
+        for (const auto &v : values)
+            acc += v;
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_multiply(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        T acc(1);
+        for (const auto &v : values)
+            acc = acc * v + T(1);
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_sort(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto copy = values;
+        state.ResumeTiming();
+        std::sort(copy.begin(), copy.end());
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_find(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+    const T missing(2000000);
+
+    for (auto _ : state) {
+        auto it = std::find(values.begin(), values.end(), missing);
+        benchmark::DoNotOptimize(it);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_bitwise(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        T acc(0);
+        for (const auto &v : values)
+            acc = (acc ^ v) | (v & T(0xFF));
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_increment(benchmark::State &state)
+{
+    const auto n = state.range(0);
+
+    for (auto _ : state) {
+        T counter(0);
+        for (std::int64_t i = 0; i < n; ++i) {
+            ++counter;
+            benchmark::DoNotOptimize(counter);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T>
+static void bm_hash_map_insert(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        std::unordered_map<T, int> map;
+        for (const auto &v : values)
+            map.emplace(v, 0);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_hash_map_lookup(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+    std::unordered_map<T, int> map;
+
+    for (const auto &v : values)
+        map.emplace(v, 0);
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (const auto &v : values)
+            found += map.count(v);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_vector_growth(benchmark::State &state)
+{
+    const auto n = state.range(0);
+
+    for (auto _ : state) {
+        std::vector<T> values;
+        for (std::int64_t i = 0; i < n; ++i)
+            values.emplace_back(i);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename HashPolicyT>
+static void bm_hash_integers(benchmark::State &state)
+{
+    using id = st::type<std::uint64_t, struct id_tag, st::hashable_with<HashPolicyT>>;
+    const auto n = static_cast<std::uint64_t>(state.range(0));
+    const std::hash<id> hasher;
+
+    for (auto _ : state) {
+        std::size_t acc = 0;
+        for (std::uint64_t i = 0; i < n; ++i)
+            acc ^= hasher(id(i));
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename HashPolicyT>
+static void bm_hash_strings(benchmark::State &state)
+{
+    using key = st::type<std::string, struct key_tag, st::hashable_with<HashPolicyT>>;
+    const key k(std::string(static_cast<std::size_t>(state.range(0)), 'k'));
+    const std::hash<key> hasher;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(k);
+        benchmark::DoNotOptimize(hasher(k));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/** Reports how far flipping a single input bit is from flipping half of the output bits, on average */
+template <typename HashPolicyT>
+static void bm_hash_avalanche(benchmark::State &state)
+{
+    using id = st::type<std::uint64_t, struct id_tag, st::hashable_with<HashPolicyT>>;
+    const auto inputs = make_values<std::int64_t>(static_cast<std::size_t>(state.range(0)));
+    const std::hash<id> hasher;
+    double bias = 0;
+
+    for (auto _ : state) {
+        std::uint64_t flipped = 0;
+        for (auto input : inputs) {
+            const auto v = static_cast<std::uint64_t>(input);
+            const std::uint64_t h = hasher(id(v));
+            for (unsigned int bit = 0; bit < 64; ++bit)
+                flipped += std::bitset<64>(h ^ hasher(id(v ^ (std::uint64_t(1) << bit)))).count();
+        }
+        bias = std::abs(static_cast<double>(flipped) / static_cast<double>(inputs.size() * 64 * 64) - 0.5);
+    }
+    state.counters["bias"] = bias;
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 64);
+}
+
+template <typename HashPolicyT>
+static void bm_hash_map_strided_ids(benchmark::State &state)
+{
+    using id = st::type<std::uint64_t, struct id_tag, st::hashable_with<HashPolicyT>, st::equality_comparable>;
+    const auto n = static_cast<std::uint64_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::unordered_map<id, int> map;
+        for (std::uint64_t i = 0; i < n; ++i)
+            map.emplace(id(i << 12), 0);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using node_id = st::type<std::uint32_t, struct node_id_tag, st::indexable, st::hashable, st::equality_comparable>;
+
+template <typename MapT>
+static void bm_id_map_lookup(benchmark::State &state)
+{
+    const auto n = static_cast<std::uint32_t>(state.range(0));
+    std::vector<node_id> keys;
+    MapT map;
+
+    for (std::uint32_t i = 0; i < n; ++i) {
+        keys.emplace_back(i);
+        map[node_id(i)] = static_cast<std::int64_t>(i);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    for (auto _ : state) {
+        std::int64_t acc = 0;
+        for (const auto &k : keys)
+            acc += map.at(k);
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using entity = st::handle<struct entity_tag>;
+
+static void bm_slot_map_lookup(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    st::slot_map<struct entity_tag, std::int64_t> map;
+    std::vector<entity> handles;
+
+    for (std::size_t i = 0; i < n; ++i)
+        handles.push_back(map.insert(static_cast<std::int64_t>(i)));
+    for (std::size_t i = 0; i < n; i += 2)
+        map.erase(handles[i]);
+    std::shuffle(handles.begin(), handles.end(), std::mt19937(42));
+    for (auto _ : state) {
+        std::int64_t acc = 0;
+        for (const auto &h : handles) {
+            if (const auto *v = map.get(h))
+                acc += *v;
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bm_handle_hash_map_lookup(benchmark::State &state)
+{
+    const auto n = static_cast<std::uint32_t>(state.range(0));
+    std::unordered_map<entity, std::int64_t> map;
+    std::vector<entity> handles;
+
+    for (std::uint32_t i = 0; i < n; ++i) {
+        handles.emplace_back(i, 1);
+        map.emplace(handles.back(), static_cast<std::int64_t>(i));
+    }
+    for (std::uint32_t i = 0; i < n; i += 2)
+        map.erase(handles[i]);
+    std::shuffle(handles.begin(), handles.end(), std::mt19937(42));
+    for (auto _ : state) {
+        std::int64_t acc = 0;
+        for (const auto &h : handles) {
+            auto it = map.find(h);
+            if (it != map.end())
+                acc += it->second;
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using string_name = st::type<std::string, struct string_name_tag, st::equality_comparable, st::hashable>;
+using interned_name = st::interned<struct interned_name_tag, st::equality_comparable, st::hashable>;
+
+template <typename NameT>
+static std::vector<NameT> make_names(std::size_t n)
+{
+    std::vector<NameT> names;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto text = "tenant/" + std::to_string(i % 64) + "/a-reasonably-long-symbol-name";
+        if constexpr (std::is_same_v<NameT, interned_name>)
+            names.push_back(st::intern<NameT>(text));
+        else
+            names.emplace_back(text);
+    }
+    return names;
+}
+
+template <typename NameT>
+static void bm_name_equality(benchmark::State &state)
+{
+    const auto names = make_names<NameT>(static_cast<std::size_t>(state.range(0)));
+    const auto needle = names[names.size() / 2];
+
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (const auto &n : names)
+            found += n == needle;
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename NameT>
+static void bm_name_hash_map_lookup(benchmark::State &state)
+{
+    const auto names = make_names<NameT>(static_cast<std::size_t>(state.range(0)));
+    std::unordered_map<NameT, int> map;
+
+    for (const auto &n : names)
+        map.emplace(n, 0);
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (const auto &n : names)
+            found += map.count(n);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename NameT>
+static void bm_name_copy(benchmark::State &state)
+{
+    const auto names = make_names<NameT>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto copy = names;
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using blob_key = st::type<std::string, struct blob_key_tag, st::equality_comparable, st::hashable>;
+using cached_blob_key = st::type<std::string, struct cached_blob_key_tag, st::equality_comparable, st::hash_cached>;
+
+template <typename KeyT>
+static std::vector<KeyT> make_blob_keys(std::size_t n)
+{
+    std::vector<KeyT> keys;
+
+    for (std::size_t i = 0; i < n; ++i)
+        keys.emplace_back(std::string(256, 'b') + std::to_string(i));
+    return keys;
+}
+
+template <typename KeyT>
+static void bm_blob_rehash(benchmark::State &state)
+{
+    const auto keys = make_blob_keys<KeyT>(static_cast<std::size_t>(state.range(0)));
+    std::unordered_map<KeyT, int> map;
+
+    for (const auto &k : keys)
+        map.emplace(k, 0);
+    for (auto _ : state) {
+        map.rehash(map.bucket_count() * 2);
+        map.rehash(0);
+        benchmark::DoNotOptimize(map.bucket_count());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+template <typename KeyT>
+static void bm_blob_lookup(benchmark::State &state)
+{
+    const auto keys = make_blob_keys<KeyT>(static_cast<std::size_t>(state.range(0)));
+    std::unordered_map<KeyT, int> map;
+
+    for (const auto &k : keys)
+        map.emplace(k, 0);
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (const auto &k : keys)
+            found += map.count(k);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename KeyT>
+static void bm_blob_hash_all(benchmark::State &state)
+{
+    const auto keys = make_blob_keys<KeyT>(static_cast<std::size_t>(state.range(0)));
+    const std::hash<KeyT> hasher;
+
+    for (auto _ : state) {
+        std::size_t acc = 0;
+        for (const auto &k : keys)
+            acc ^= hasher(k);
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using long_name = st::type<std::string, struct long_name_tag>;
+
+static void bm_emplace_names_from_temporary(benchmark::State &state)
+{
+    const std::string text(64, 'n');
+
+    for (auto _ : state) {
+        std::vector<long_name> names;
+        names.reserve(static_cast<std::size_t>(state.range(0)));
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            names.emplace_back(std::string(text.data(), text.size()));
+        benchmark::DoNotOptimize(names.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bm_emplace_names_in_place(benchmark::State &state)
+{
+    const std::string text(64, 'n');
+
+    for (auto _ : state) {
+        std::vector<long_name> names;
+        names.reserve(static_cast<std::size_t>(state.range(0)));
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            names.emplace_back(std::in_place, text.data(), text.size());
+        benchmark::DoNotOptimize(names.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using pmr_label = st::type<std::pmr::string, struct pmr_label_tag, st::equality_comparable>;
+
+static void bm_pmr_labels_default_resource(benchmark::State &state)
+{
+    const std::string text(64, 'l');
+
+    for (auto _ : state) {
+        std::pmr::vector<pmr_label> labels;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            labels.emplace_back(text.c_str());
+        benchmark::DoNotOptimize(labels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bm_pmr_labels_arena(benchmark::State &state)
+{
+    const std::string text(64, 'l');
+    std::vector<std::byte> buffer(static_cast<std::size_t>(state.range(0)) * 256);
+
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+        std::pmr::vector<pmr_label> labels(&arena);
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            labels.emplace_back(text.c_str());
+        benchmark::DoNotOptimize(labels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using string_cell = st::type<std::string, struct string_cell_tag>;
+using owner_cell = st::type<std::unique_ptr<std::int64_t>, struct owner_cell_tag>;
+using array_cell = st::type<std::vector<std::int64_t>, struct array_cell_tag>;
+
+template <typename CellT>
+static CellT make_cell(std::int64_t i)
+{
+    if constexpr (std::is_same_v<CellT, string_cell>)
+        return CellT(std::string(32, 'c') + std::to_string(i));
+    else if constexpr (std::is_same_v<CellT, owner_cell>)
+        return CellT(std::make_unique<std::int64_t>(i));
+    else
+        return CellT(std::vector<std::int64_t>(4, i));
+}
+
+template <typename ColumnT>
+static void bm_column_growth(benchmark::State &state)
+{
+    using cell = typename ColumnT::value_type;
+
+    for (auto _ : state) {
+        ColumnT column;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            column.push_back(make_cell<cell>(i));
+        benchmark::DoNotOptimize(column.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename ColumnT>
+static void bm_column_insert_erase_front(benchmark::State &state)
+{
+    using cell = typename ColumnT::value_type;
+    ColumnT column;
+
+    for (std::int64_t i = 0; i < state.range(0); ++i)
+        column.push_back(make_cell<cell>(i));
+    for (auto _ : state) {
+        column.insert(column.begin(), make_cell<cell>(-1));
+        column.erase(column.begin());
+        benchmark::DoNotOptimize(column.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+using wrapping_int = st::type<std::int64_t, struct wrapping_int_tag, st::arithmetic_wrapping>;
+using saturating_int = st::type<std::int64_t, struct saturating_int_tag, st::arithmetic_saturating>;
+using checked_int = st::type<std::int64_t, struct checked_int_tag, st::arithmetic_checked<>>;
+using trapping_int = st::type<std::int64_t, struct trapping_int_tag, st::arithmetic_trapping>;
+
+template <typename T>
+static void bm_overflow_accumulate(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        T acc(0);
+        for (const auto &v : values)
+            acc += v;
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** Hand-written range check before each addition, as done without the checked traits */
+static void bm_overflow_accumulate_prechecked(benchmark::State &state)
+{
+    using limits = std::numeric_limits<std::int64_t>;
+    const auto values = make_values<std::int64_t>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        std::int64_t acc = 0;
+        for (const auto v : values) {
+            if (v > 0 ? acc > limits::max() - v : acc < limits::min() - v)
+                throw std::overflow_error("overflow");
+            acc += v;
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_overflow_multiply_add(benchmark::State &state)
+{
+    const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+    std::vector<T> out(values.size());
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < values.size(); ++i)
+            out[i] = values[i] * values[i] + T(1);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using int_port = st::type<int, struct int_port_tag, st::orderable>;
+using bounded_port = st::bounded<0, 65535, struct bounded_port_tag, st::orderable>;
+
+template <typename PortT>
+static void bm_port_column_scan(benchmark::State &state)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 65535);
+    std::vector<PortT> ports;
+    const PortT privileged(1024);
+
+    ports.reserve(static_cast<std::size_t>(state.range(0)));
+    for (std::int64_t i = 0; i < state.range(0); ++i)
+        ports.emplace_back(dist(rng));
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        std::int64_t count = 0;
+        for (const auto &p : ports) {
+            total += p.value();
+            count += p < privileged;
+        }
+        benchmark::DoNotOptimize(total);
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(PortT)));
+}
+
+using level = st::bounded<0, 7, struct level_tag, st::orderable>;
+using reading = st::bounded<0, 4095, struct reading_tag, st::orderable>;
+
+template <typename S>
+static std::size_t column_bytes(const std::vector<S> &column) noexcept
+{
+    return column.capacity() * sizeof(S);
+}
+
+template <typename S, std::size_t Bits>
+static std::size_t column_bytes(const st::packed_vector<S, Bits> &column) noexcept
+{
+    return column.memory_usage();
+}
+
+template <typename ColumnT>
+static ColumnT make_column(std::int64_t size)
+{
+    using value_type = typename ColumnT::value_type;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(value_type::min_value, value_type::max_value);
+    ColumnT column;
+
+    column.reserve(static_cast<std::size_t>(size));
+    for (std::int64_t i = 0; i < size; ++i)
+        column.push_back(value_type(dist(rng)));
+    return column;
+}
+
+template <typename ColumnT>
+static void bm_packed_column_scan(benchmark::State &state)
+{
+    const ColumnT column = make_column<ColumnT>(state.range(0));
+    const typename ColumnT::value_type threshold(ColumnT::value_type::max_value / 2);
+
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        std::int64_t count = 0;
+        for (const auto &v : column) {
+            total += v.value();
+            count += v < threshold;
+        }
+        benchmark::DoNotOptimize(total);
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_value"] = static_cast<double>(column_bytes(column)) / static_cast<double>(state.range(0));
+}
+
+/** Scans a packed column by unpacking it in chunks which stay in L1 cache */
+template <typename S>
+static void bm_packed_column_unpack_scan(benchmark::State &state)
+{
+    const auto column = make_column<st::packed_vector<S>>(state.range(0));
+    const S threshold(S::max_value / 2);
+    std::vector<S> chunk(4096);
+
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        std::int64_t count = 0;
+        for (std::size_t first = 0; first < column.size(); first += chunk.size()) {
+            const auto values = st::span<S>(chunk).first(std::min(chunk.size(), column.size() - first));
+
+            column.unpack(first, values);
+            for (const auto &v : values) {
+                total += v.value();
+                count += v < threshold;
+            }
+        }
+        benchmark::DoNotOptimize(total);
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_value"] = static_cast<double>(column_bytes(column)) / static_cast<double>(state.range(0));
+}
+
+/** Samples with eager element-wise operators, which allocate their result unless they can reuse an rvalue operand */
+class samples
+{
+public:
+    static inline std::int64_t allocations = 0;
+
+    samples() noexcept = default;
+
+    explicit samples(std::size_t n) : _values((++allocations, n))
+    {
+    }
+
+    samples(const samples &other) : _values((++allocations, other._values))
+    {
+    }
+
+    samples(samples &&) noexcept = default;
+
+    samples &operator=(const samples &) = default;
+
+    samples &operator=(samples &&) noexcept = default;
+
+    std::size_t size() const noexcept
+    {
+        return _values.size();
+    }
+
+    double &operator[](std::size_t i) noexcept
+    {
+        return _values[i];
+    }
+
+    const double &operator[](std::size_t i) const noexcept
+    {
+        return _values[i];
+    }
+
+    friend samples operator+(const samples &lhs, const samples &rhs)
+    {
+        samples ret(lhs.size());
+
+        for (std::size_t i = 0; i < ret.size(); ++i)
+            ret[i] = lhs[i] + rhs[i];
+        return ret;
+    }
+
+    friend samples operator+(samples &&lhs, const samples &rhs)
+    {
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            lhs[i] += rhs[i];
+        return std::move(lhs);
+    }
+
+    friend samples operator+(const samples &lhs, samples &&rhs)
+    {
+        return std::move(rhs) + lhs;
+    }
+
+    friend samples operator+(samples &&lhs, samples &&rhs)
+    {
+        return std::move(lhs) + static_cast<const samples &>(rhs);
+    }
+
+    friend samples operator-(const samples &lhs, const samples &rhs)
+    {
+        samples ret(lhs.size());
+
+        for (std::size_t i = 0; i < ret.size(); ++i)
+            ret[i] = lhs[i] - rhs[i];
+        return ret;
+    }
+
+    friend samples operator-(samples &&lhs, const samples &rhs)
+    {
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            lhs[i] -= rhs[i];
+        return std::move(lhs);
+    }
+
+    friend samples operator*(const samples &lhs, double k)
+    {
+        samples ret(lhs.size());
+
+        for (std::size_t i = 0; i < ret.size(); ++i)
+            ret[i] = lhs[i] * k;
+        return ret;
+    }
+
+    friend samples operator*(samples &&lhs, double k)
+    {
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            lhs[i] *= k;
+        return std::move(lhs);
+    }
+
+private:
+    std::vector<double> _values;
+};
+
+using eager_signal = st::type<samples, struct eager_signal_tag, st::addable, st::subtractable,
+                              st::multiplicable_with<double>>;
+using lazy_signal = st::type<samples, struct lazy_signal_tag, st::lazy_arithmetic>;
+
+template <typename SignalT>
+static std::vector<SignalT> make_signals(std::size_t count, std::int64_t size)
+{
+    std::vector<SignalT> signals;
+
+    for (std::size_t s = 0; s < count; ++s) {
+        samples values(static_cast<std::size_t>(size));
+
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<double>(i * (s + 1)) * 0.25;
+        signals.emplace_back(std::move(values));
+    }
+    return signals;
+}
+
+/** Reports allocations per evaluation, and bandwidth as if each input and the output were only streamed once */
+static void report_signals(benchmark::State &state, std::int64_t inputs)
+{
+    state.counters["allocations"] = static_cast<double>(samples::allocations) /
+                                    static_cast<double>(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (inputs + 1) *
+                            static_cast<std::int64_t>(sizeof(double)));
+}
+
+template <typename SignalT>
+static void bm_signal_expression_short(benchmark::State &state)
+{
+    const auto s = make_signals<SignalT>(3, state.range(0));
+
+    samples::allocations = 0;
+    for (auto _ : state) {
+        SignalT r = s[0] + s[1] * 0.5 + s[2];
+        benchmark::DoNotOptimize(r.value()[0]);
+    }
+    report_signals(state, 3);
+}
+
+template <typename SignalT>
+static void bm_signal_expression_long(benchmark::State &state)
+{
+    const auto s = make_signals<SignalT>(7, state.range(0));
+
+    samples::allocations = 0;
+    for (auto _ : state) {
+        SignalT r = s[0] + s[1] * 0.5 + s[2] - s[3] * 0.25 + s[4] + s[5] * 2.0 - s[6];
+        benchmark::DoNotOptimize(r.value()[0]);
+    }
+    report_signals(state, 7);
+}
+
+using event_time = st::type<std::uint64_t, struct event_time_tag, st::orderable, st::equality_comparable>;
+using sample_value = st::type<double, struct sample_value_tag, st::orderable>;
+
+struct std_algorithms
+{
+    template <typename It>
+    static void sort(It first, It last)
+    {
+        std::sort(first, last);
+    }
+
+    template <typename It>
+    static void stable_sort(It first, It last)
+    {
+        std::stable_sort(first, last);
+    }
+
+    template <typename It, typename T>
+    static It lower_bound(It first, It last, const T &value)
+    {
+        return std::lower_bound(first, last, value);
+    }
+};
+
+struct st_algorithms
+{
+    template <typename It>
+    static void sort(It first, It last)
+    {
+        st::sort(first, last);
+    }
+
+    template <typename It>
+    static void stable_sort(It first, It last)
+    {
+        st::stable_sort(first, last);
+    }
+
+    template <typename It, typename T>
+    static It lower_bound(It first, It last, const T &value)
+    {
+        return st::lower_bound(first, last, value);
+    }
+};
+
+/** Nanosecond timestamps spread over a day, whose two high bytes are shared */
+static std::vector<event_time> make_event_times(std::size_t n)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::uint64_t> dist(0, 86400000000000);
+    std::vector<event_time> times;
+
+    times.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        times.emplace_back(1700000000000000000 + dist(rng));
+    return times;
+}
+
+static std::vector<sample_value> make_sample_values(std::size_t n)
+{
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> dist(0, 1000);
+    std::vector<sample_value> samples;
+
+    samples.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        samples.emplace_back(dist(rng));
+    return samples;
+}
+
+template <typename AlgorithmsT>
+static void bm_sort_event_times(benchmark::State &state)
+{
+    const auto values = make_event_times(static_cast<std::size_t>(state.range(0)));
+    auto copy = values;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::copy(values.begin(), values.end(), copy.begin());
+        state.ResumeTiming();
+        AlgorithmsT::sort(copy.begin(), copy.end());
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename AlgorithmsT>
+static void bm_stable_sort_event_times(benchmark::State &state)
+{
+    const auto values = make_event_times(static_cast<std::size_t>(state.range(0)));
+    auto copy = values;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::copy(values.begin(), values.end(), copy.begin());
+        state.ResumeTiming();
+        AlgorithmsT::stable_sort(copy.begin(), copy.end());
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename AlgorithmsT>
+static void bm_sort_sample_values(benchmark::State &state)
+{
+    const auto values = make_sample_values(static_cast<std::size_t>(state.range(0)));
+    auto copy = values;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::copy(values.begin(), values.end(), copy.begin());
+        state.ResumeTiming();
+        AlgorithmsT::sort(copy.begin(), copy.end());
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename AlgorithmsT>
+static void bm_lower_bound_event_times(benchmark::State &state)
+{
+    auto values = make_event_times(static_cast<std::size_t>(state.range(0)));
+    const auto queries = make_event_times(4096);
+
+    st::sort(values.begin(), values.end());
+    for (auto _ : state) {
+        for (const auto &query : queries)
+            benchmark::DoNotOptimize(AlgorithmsT::lower_bound(values.begin(), values.end(), query));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+}
+
+using byte_count = st::type<std::uint64_t, struct byte_count_tag, st::addable, st::orderable>;
+
+static std::vector<byte_count> make_byte_counts(std::int64_t n)
+{
+    std::mt19937_64 rng(42);
+    std::vector<byte_count> counts;
+
+    counts.reserve(static_cast<std::size_t>(n));
+    for (std::int64_t i = 0; i < n; ++i)
+        counts.emplace_back(rng() % 65536);
+    return counts;
+}
+
+/** Runs parallel benchmarks over 1, 2, 4... threads, up to the number of hardware threads */
+static void parallel_arguments(benchmark::internal::Benchmark *bm)
+{
+    const auto max_threads = static_cast<std::int64_t>(st::parallel::details::default_concurrency());
+
+    for (std::int64_t size : {std::int64_t(1) << 20, std::int64_t(1) << 27}) {
+        for (std::int64_t threads = 1; threads < max_threads * 2; threads *= 2)
+            bm->Args({size, std::min(threads, max_threads)});
+    }
+}
+
+static void bm_parallel_reduce(benchmark::State &state)
+{
+    const auto counts = make_byte_counts(state.range(0));
+    st::parallel::thread_pool pool(static_cast<std::size_t>(state.range(1)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(st::parallel::reduce(pool, counts));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(byte_count)));
+}
+
+static void bm_parallel_max(benchmark::State &state)
+{
+    const auto counts = make_byte_counts(state.range(0));
+    st::parallel::thread_pool pool(static_cast<std::size_t>(state.range(1)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(st::parallel::max(pool, counts));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(byte_count)));
+}
+
+static void bm_parallel_histogram(benchmark::State &state)
+{
+    const auto counts = make_byte_counts(state.range(0));
+    st::parallel::thread_pool pool(static_cast<std::size_t>(state.range(1)));
+    const auto bucket_of = [](const byte_count &c) { return static_cast<std::size_t>(c.value() >> 12); };
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(st::parallel::histogram(pool, counts, 16, bucket_of));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(byte_count)));
+}
+
+static void bm_parallel_prefix_sum(benchmark::State &state)
+{
+    const auto counts = make_byte_counts(state.range(0));
+    std::vector<byte_count> sums(counts.size());
+    st::parallel::thread_pool pool(static_cast<std::size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        st::parallel::prefix_sum(pool, counts, sums);
+        benchmark::DoNotOptimize(sums.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(byte_count)));
+}
+
+using parent_id = st::type<std::uint32_t, struct parent_id_tag, st::has_sentinel<-1>, st::equality_comparable>;
+
+/** Sums the parents of a forest stored as an array of optional parents, the roots having none */
+template <typename OptionalT>
+static void bm_optional_parents_scan(benchmark::State &state)
+{
+    std::mt19937_64 rng(42);
+    std::vector<OptionalT> parents(static_cast<std::size_t>(state.range(0)));
+
+    for (std::size_t i = 1; i < parents.size(); ++i) {
+        if (rng() % 8 != 0)
+            parents[i] = parent_id(static_cast<std::uint32_t>(rng() % i));
+    }
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+
+        for (const auto &parent : parents) {
+            if (parent)
+                sum += parent->value();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(OptionalT)));
+    state.counters["bytes_per_element"] = sizeof(OptionalT);
+}
+
+template <typename T>
+using atomic_of = std::conditional_t<st::is_strong_type_v<T>, st::atomic<T>, std::atomic<T>>;
+
+template <typename T>
+static void bm_atomic_fetch_add(benchmark::State &state)
+{
+    static atomic_of<T> counter;
+
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            benchmark::DoNotOptimize(counter.fetch_add(T(1), std::memory_order_relaxed));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void bm_atomic_compare_exchange_max(benchmark::State &state)
+{
+    static atomic_of<T> maximum;
+    std::int64_t next = state.thread_index();
+
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            const T candidate(next);
+            T current = maximum.load(std::memory_order_relaxed);
+
+            while (current < candidate &&
+                   !maximum.compare_exchange_weak(current, candidate, std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed));
+            next += state.threads();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename CounterT>
+static void bm_counter_add(benchmark::State &state)
+{
+    using value_type = typename CounterT::value_type;
+    static CounterT counter;
+
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            counter += value_type(1);
+    }
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define STRONG_TYPE_OVERFLOW_BENCHMARK(name, ...)                   \
+    BENCHMARK_TEMPLATE(name, strong_int)->__VA_ARGS__;              \
+    BENCHMARK_TEMPLATE(name, wrapping_int)->__VA_ARGS__;            \
+    BENCHMARK_TEMPLATE(name, saturating_int)->__VA_ARGS__;          \
+    BENCHMARK_TEMPLATE(name, checked_int)->__VA_ARGS__;             \
+    BENCHMARK_TEMPLATE(name, trapping_int)->__VA_ARGS__
+
+#define STRONG_TYPE_COLUMN_BENCHMARK(name, ...)                             \
+    BENCHMARK_TEMPLATE(name, std::vector<string_cell>)->__VA_ARGS__;        \
+    BENCHMARK_TEMPLATE(name, st::vector<string_cell>)->__VA_ARGS__;         \
+    BENCHMARK_TEMPLATE(name, std::vector<owner_cell>)->__VA_ARGS__;         \
+    BENCHMARK_TEMPLATE(name, st::vector<owner_cell>)->__VA_ARGS__;          \
+    BENCHMARK_TEMPLATE(name, std::vector<array_cell>)->__VA_ARGS__;         \
+    BENCHMARK_TEMPLATE(name, st::vector<array_cell>)->__VA_ARGS__
+
+#define STRONG_TYPE_BLOB_BENCHMARK(name, ...)                       \
+    BENCHMARK_TEMPLATE(name, blob_key)->__VA_ARGS__;                \
+    BENCHMARK_TEMPLATE(name, cached_blob_key)->__VA_ARGS__
+
+#define STRONG_TYPE_NAME_BENCHMARK(name, ...)                       \
+    BENCHMARK_TEMPLATE(name, string_name)->__VA_ARGS__;             \
+    BENCHMARK_TEMPLATE(name, interned_name)->__VA_ARGS__
+
+#define STRONG_TYPE_HASH_BENCHMARK(name, ...)                                       \
+    BENCHMARK_TEMPLATE(name, st::hash_policies::standard)->__VA_ARGS__;             \
+    BENCHMARK_TEMPLATE(name, st::hash_policies::fibonacci)->__VA_ARGS__;            \
+    BENCHMARK_TEMPLATE(name, st::hash_policies::wyhash)->__VA_ARGS__;               \
+    BENCHMARK_TEMPLATE(name, st::hash_policies::identity)->__VA_ARGS__
+
+#define STRONG_TYPE_ALGORITHM_BENCHMARK(name, ...)                  \
+    BENCHMARK_TEMPLATE(name, std_algorithms)->__VA_ARGS__;          \
+    BENCHMARK_TEMPLATE(name, st_algorithms)->__VA_ARGS__
+
+#define STRONG_TYPE_BENCHMARK(name, ...)                            \
+    BENCHMARK_TEMPLATE(name, raw_int)->__VA_ARGS__;                 \
+    BENCHMARK_TEMPLATE(name, strong_int)->__VA_ARGS__
+
+STRONG_TYPE_BENCHMARK(bm_accumulate, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_accumulate_in_place, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_multiply, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_sort, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_find, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_bitwise, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_increment, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_hash_map_insert, Range(1 << 10, 1 << 18));
+STRONG_TYPE_BENCHMARK(bm_hash_map_lookup, Range(1 << 10, 1 << 18));
+STRONG_TYPE_BENCHMARK(bm_vector_growth, Range(1 << 10, 1 << 20));
+STRONG_TYPE_BENCHMARK(bm_atomic_fetch_add, Arg(1 << 10)->ThreadRange(1, 8)->UseRealTime());
+STRONG_TYPE_BENCHMARK(bm_atomic_compare_exchange_max, Arg(1 << 10)->ThreadRange(1, 8)->UseRealTime());
+
+STRONG_TYPE_OVERFLOW_BENCHMARK(bm_overflow_accumulate, Range(1 << 10, 1 << 20));
+BENCHMARK(bm_overflow_accumulate_prechecked)->Range(1 << 10, 1 << 20);
+STRONG_TYPE_OVERFLOW_BENCHMARK(bm_overflow_multiply_add, Range(1 << 10, 1 << 20));
+
+BENCHMARK_TEMPLATE(bm_port_column_scan, int_port)->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(bm_port_column_scan, bounded_port)->Range(1 << 10, 1 << 24);
+
+BENCHMARK_TEMPLATE(bm_packed_column_scan, std::vector<level>)->Arg(1 << 16)->Arg(100000000);
+BENCHMARK_TEMPLATE(bm_packed_column_scan, st::packed_vector<level>)->Arg(1 << 16)->Arg(100000000);
+BENCHMARK_TEMPLATE(bm_packed_column_unpack_scan, level)->Arg(1 << 16)->Arg(100000000);
+BENCHMARK_TEMPLATE(bm_packed_column_scan, std::vector<reading>)->Arg(1 << 16)->Arg(100000000);
+BENCHMARK_TEMPLATE(bm_packed_column_scan, st::packed_vector<reading>)->Arg(1 << 16)->Arg(100000000);
+BENCHMARK_TEMPLATE(bm_packed_column_unpack_scan, reading)->Arg(1 << 16)->Arg(100000000);
+
+BENCHMARK_TEMPLATE(bm_signal_expression_short, eager_signal)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_signal_expression_short, lazy_signal)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_signal_expression_long, eager_signal)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_signal_expression_long, lazy_signal)->Range(1 << 10, 1 << 22);
+
+STRONG_TYPE_ALGORITHM_BENCHMARK(bm_sort_event_times,
+                                Arg(1 << 16)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond));
+STRONG_TYPE_ALGORITHM_BENCHMARK(bm_stable_sort_event_times, Arg(1 << 16)->Arg(10000000)->Unit(benchmark::kMillisecond));
+STRONG_TYPE_ALGORITHM_BENCHMARK(bm_sort_sample_values, Arg(1 << 16)->Arg(10000000)->Unit(benchmark::kMillisecond));
+STRONG_TYPE_ALGORITHM_BENCHMARK(bm_lower_bound_event_times, Arg(1 << 10)->Arg(1 << 20)->Arg(10000000)->Arg(100000000));
+
+BENCHMARK(bm_parallel_reduce)->Apply(parallel_arguments)->UseRealTime();
+BENCHMARK(bm_parallel_max)->Apply(parallel_arguments)->UseRealTime();
+BENCHMARK(bm_parallel_histogram)->Apply(parallel_arguments)->UseRealTime();
+BENCHMARK(bm_parallel_prefix_sum)->Apply(parallel_arguments)->UseRealTime();
+
+BENCHMARK_TEMPLATE(bm_optional_parents_scan, std::optional<parent_id>)->Arg(1 << 16)->Arg(1 << 26);
+BENCHMARK_TEMPLATE(bm_optional_parents_scan, st::optional<parent_id>)->Arg(1 << 16)->Arg(1 << 26);
+
+STRONG_TYPE_HASH_BENCHMARK(bm_hash_integers, Range(1 << 10, 1 << 20));
+STRONG_TYPE_HASH_BENCHMARK(bm_hash_avalanche, Arg(1 << 10));
+STRONG_TYPE_HASH_BENCHMARK(bm_hash_map_strided_ids, Range(1 << 10, 1 << 18));
+BENCHMARK_TEMPLATE(bm_hash_strings, st::hash_policies::standard)->Range(8, 1 << 12);
+BENCHMARK_TEMPLATE(bm_hash_strings, st::hash_policies::wyhash)->Range(8, 1 << 12);
+
+BENCHMARK_TEMPLATE(bm_id_map_lookup, std::unordered_map<node_id, std::int64_t>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(bm_id_map_lookup, st::dense_map<node_id, std::int64_t>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(bm_counter_add, st::atomic<strong_int>)->Arg(1 << 10)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_counter_add, st::sharded<strong_int>)->Arg(1 << 10)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK(bm_handle_hash_map_lookup)->Range(1 << 10, 1 << 20);
+BENCHMARK(bm_slot_map_lookup)->Range(1 << 10, 1 << 20);
+
+STRONG_TYPE_NAME_BENCHMARK(bm_name_equality, Range(1 << 10, 1 << 16));
+STRONG_TYPE_NAME_BENCHMARK(bm_name_hash_map_lookup, Range(1 << 10, 1 << 16));
+STRONG_TYPE_NAME_BENCHMARK(bm_name_copy, Range(1 << 10, 1 << 16));
+
+STRONG_TYPE_BLOB_BENCHMARK(bm_blob_hash_all, Range(1 << 10, 1 << 16));
+STRONG_TYPE_BLOB_BENCHMARK(bm_blob_rehash, Range(1 << 10, 1 << 16));
+STRONG_TYPE_BLOB_BENCHMARK(bm_blob_lookup, Range(1 << 10, 1 << 16));
+
+STRONG_TYPE_COLUMN_BENCHMARK(bm_column_growth, Range(1 << 10, 1 << 16));
+STRONG_TYPE_COLUMN_BENCHMARK(bm_column_insert_erase_front, Range(1 << 10, 1 << 16));
+
+BENCHMARK(bm_emplace_names_from_temporary)->Range(1 << 8, 1 << 14);
+BENCHMARK(bm_emplace_names_in_place)->Range(1 << 8, 1 << 14);
+BENCHMARK(bm_pmr_labels_default_resource)->Range(1 << 8, 1 << 14);
+BENCHMARK(bm_pmr_labels_arena)->Range(1 << 8, 1 << 14);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+# Compiles SOURCE to assembly and checks that every raw_<name> function has exactly the same instructions as its
+# strong_<name> counterpart.
+#
+# Compilers sometimes canonicalize a comparison differently depending on where it was inlined from, which swaps its
+# operands and mirrors the condition code of its users. Such functions are accepted, but reported, as long as the only
+# differences are cmp/test instructions with swapped operands, each immediately followed by set/cmov/j instructions
+# using the mirrored condition code. Any other difference is a mismatch.
+#
+# Usage:
+#   cmake -DCXX=<compiler> -DSOURCE=<file.cpp> -DINCLUDE_DIR=<dir> -DFLAGS="<flags>" -DOUTPUT=<file.s>
+#         -P CheckCodegen.cmake
+
+foreach (var CXX SOURCE INCLUDE_DIR OUTPUT)
+    if (NOT DEFINED ${var})
+        message(FATAL_ERROR "CheckCodegen: ${var} is not defined")
+    endif ()
+endforeach ()
+
+separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+
+execute_process(
+        COMMAND ${CXX} -std=c++17 ${flags} -I${INCLUDE_DIR} -S ${SOURCE} -o ${OUTPUT}
+        RESULT_VARIABLE result
+        ERROR_VARIABLE error
+)
+
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "CheckCodegen: unable to compile ${SOURCE}:\n${error}")
+endif ()
+
+file(STRINGS ${OUTPUT} lines)
+
+set(current "")
+set(names "")
+
+foreach (line IN LISTS lines)
+    if (line MATCHES "^_?(raw|strong)_([A-Za-z0-9_]+):")
+        set(current "${CMAKE_MATCH_1}_${CMAKE_MATCH_2}")
+        set(body_${current} "")
+        set(lines_${current} "")
+        if (CMAKE_MATCH_1 STREQUAL "raw")
+            list(APPEND names ${CMAKE_MATCH_2})
+        endif ()
+    elseif (NOT current STREQUAL "")
+        string(STRIP "${line}" line)
+        if (line MATCHES "^\\.cfi_endproc" OR line MATCHES "^\\.size" OR line MATCHES "^\\.Lfunc_end")
+            set(current "")
+        elseif (NOT line STREQUAL "" AND NOT line MATCHES "^(#|\\.cfi_|\\.loc|\\.LF[BE][0-9]+:)")
+            # Normalize comments, local labels and self-references, which legitimately differ between functions
+            string(REGEX REPLACE "[ \t]*#.*$" "" line "${line}")
+            string(REGEX REPLACE "\\.?L[A-Za-z_]*[0-9][0-9_]*" "<label>" line "${line}")
+            string(REGEX REPLACE "(raw|strong)_" "<fn>_" line "${line}")
+            string(REGEX REPLACE "[ \t]+" " " line "${line}")
+            string(APPEND body_${current} "    ${line}\n")
+            list(APPEND lines_${current} "${line}")
+        endif ()
+    endif ()
+endforeach ()
+
+if (names STREQUAL "")
+    message(FATAL_ERROR "CheckCodegen: no raw_* functions found in ${OUTPUT}")
+endif ()
+
+# Condition code used once the operands of the comparison setting the flags are swapped, empty if there is none
+function(mirror_condition_code cc out)
+    set(pairs e:e ne:ne z:z nz:nz l:g g:l le:ge ge:le b:a a:b be:ae ae:be)
+    set(${out} "" PARENT_SCOPE)
+    foreach (pair IN LISTS pairs)
+        if (pair MATCHES "^${cc}:(.+)$")
+            set(${out} "${CMAKE_MATCH_1}" PARENT_SCOPE)
+        endif ()
+    endforeach ()
+endfunction ()
+
+# Sets out to TRUE if the instructions of raw and strong only differ by comparisons with swapped operands
+function(equal_up_to_swapped_comparisons raw strong out)
+    set(${out} FALSE PARENT_SCOPE)
+    list(LENGTH ${raw} count)
+    list(LENGTH ${strong} strong_count)
+    if (NOT count EQUAL strong_count)
+        return()
+    endif ()
+
+    set(i 0)
+    while (i LESS count)
+        list(GET ${raw} ${i} a)
+        list(GET ${strong} ${i} b)
+        math(EXPR i "${i} + 1")
+        if (a STREQUAL b)
+            continue()
+        endif ()
+        if (NOT a MATCHES "^(cmp|test)([a-z]*) ([^ ]+), ([^ ]+)$")
+            return()
+        endif ()
+        if (NOT b STREQUAL "${CMAKE_MATCH_1}${CMAKE_MATCH_2} ${CMAKE_MATCH_4}, ${CMAKE_MATCH_3}")
+            return()
+        endif ()
+        # test is commutative, so that its users keep their condition code
+        set(mirrored FALSE)
+        if (CMAKE_MATCH_1 STREQUAL "cmp")
+            set(mirrored TRUE)
+        endif ()
+
+        set(users 0)
+        while (i LESS count)
+            list(GET ${raw} ${i} a)
+            list(GET ${strong} ${i} b)
+            if (a MATCHES "^jmp( |$)" OR NOT a MATCHES "^(set|cmov|j)([a-z]+)( .*)?$")
+                break()
+            endif ()
+            set(expected "${a}")
+            if (mirrored)
+                mirror_condition_code("${CMAKE_MATCH_2}" cc)
+                if (cc STREQUAL "")
+                    return()
+                endif ()
+                set(expected "${CMAKE_MATCH_1}${cc}${CMAKE_MATCH_3}")
+            endif ()
+            if (NOT b STREQUAL expected)
+                return()
+            endif ()
+            math(EXPR users "${users} + 1")
+            math(EXPR i "${i} + 1")
+        endwhile ()
+        if (users EQUAL 0)
+            return()
+        endif ()
+    endwhile ()
+    set(${out} TRUE PARENT_SCOPE)
+endfunction ()
+
+set(mismatches "")
+
+foreach (name IN LISTS names)
+    if (NOT DEFINED body_strong_${name})
+        string(APPEND mismatches "strong_${name} is missing\n")
+    elseif (NOT body_raw_${name} STREQUAL body_strong_${name})
+        equal_up_to_swapped_comparisons(lines_raw_${name} lines_strong_${name} swapped)
+        if (swapped)
+            message(STATUS "CheckCodegen (${FLAGS}): ${name} is identical up to the order of comparison operands")
+        else ()
+            string(APPEND mismatches
+                    "${name} differs:\n  raw:\n${body_raw_${name}}  strong:\n${body_strong_${name}}\n")
+        endif ()
+    endif ()
+endforeach ()
+
+if (NOT mismatches STREQUAL "")
+    message(FATAL_ERROR "CheckCodegen (${FLAGS}): strong types generate different code:\n${mismatches}")
+endif ()
+
+list(LENGTH names count)
+message(STATUS "CheckCodegen (${FLAGS}): ${count} functions compile identically")
@@ -0,0 +1,268 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_ALGORITHM_HPP
+#define STRONG_TYPE_ALGORITHM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <st/traits.hpp>
+#include <st/is_strong_type.hpp>
+
+/**
+ * Sorting and searching algorithms over ranges of strong types
+ *
+ * They behave as their standard counterparts using operator<, and are faster for orderable strong types wrapping
+ * integral or floating point values: sort() and stable_sort() use a least significant digit radix sort, and
+ * lower_bound() / upper_bound() a binary search which does not branch on comparisons. Other ranges are handed to
+ * the standard algorithms.
+ */
+namespace st
+{
+    namespace details
+    {
+        template <typename V, typename = void>
+        struct radix_key
+        {
+        };
+
+        /** Integers are ordered as unsigned integers once their sign bit is flipped */
+        template <typename V>
+        struct radix_key<V, std::enable_if_t<std::is_integral_v<V> && !std::is_same_v<V, bool>>>
+        {
+            using type = std::make_unsigned_t<V>;
+
+            static constexpr type sign_flip = std::is_signed_v<V> ? type(type(1) << (sizeof(V) * 8 - 1)) : type(0);
+
+            static constexpr type key(V v) noexcept
+            {
+                return static_cast<type>(static_cast<type>(v) ^ sign_flip);
+            }
+        };
+
+        /**
+         * IEEE floating point values are ordered as unsigned integers once the sign bit of positive values and all
+         * the bits of negative values are flipped
+         *
+         * -0.0 is keyed as +0.0, since they compare equal and stable sorts must keep them in order. NaNs are keyed by
+         * their bits, and end up before or after all other values depending on their sign.
+         */
+        template <typename V>
+        struct radix_key<V, std::enable_if_t<
+            std::is_floating_point_v<V> && std::numeric_limits<V>::is_iec559 && (sizeof(V) == 4 || sizeof(V) == 8)
+        >>
+        {
+            using type = std::conditional_t<sizeof(V) == 4, std::uint32_t, std::uint64_t>;
+
+            static type key(V v) noexcept
+            {
+                constexpr unsigned int sign_shift = sizeof(V) * 8 - 1;
+                const V normalized = v + V(0);
+                type bits;
+
+                std::memcpy(&bits, &normalized, sizeof(bits));
+                return bits ^ (type(-(bits >> sign_shift)) | (type(1) << sign_shift));
+            }
+        };
+
+        template <typename V, typename = void>
+        inline constexpr bool has_radix_key_v = false;
+
+        template <typename V>
+        inline constexpr bool has_radix_key_v<V, std::void_t<typename radix_key<V>::type>> = true;
+
+        template <typename S, bool = is_strong_type_v<S>>
+        inline constexpr bool is_radix_orderable_v = false;
+
+        /** Whether operator< orders S by its arithmetic underlying value, as the orderable trait does */
+        template <typename S>
+        inline constexpr bool is_radix_orderable_v<S, true> =
+            std::is_base_of_v<traits::orderable<S>, S> && has_radix_key_v<typename S::value_type>;
+
+        template <typename It>
+        inline constexpr bool is_random_access_v = std::is_base_of_v<
+            std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category
+        >;
+
+        template <typename It>
+        inline constexpr bool uses_radix_sort_v =
+            is_random_access_v<It> && is_radix_orderable_v<typename std::iterator_traits<It>::value_type>;
+
+        template <typename It>
+        inline constexpr bool uses_branchless_search_v =
+            is_random_access_v<It> && is_radix_orderable_v<typename std::iterator_traits<It>::value_type>;
+
+        /** Below this size, comparison sorts are faster than counting digits */
+        inline constexpr std::size_t radix_sort_threshold = 256;
+
+        inline constexpr unsigned int radix_digit_bits = 8;
+        inline constexpr std::size_t radix_buckets = std::size_t(1) << radix_digit_bits;
+
+        constexpr unsigned int radix_shift(std::size_t digit) noexcept
+        {
+            return static_cast<unsigned int>(digit * radix_digit_bits);
+        }
+
+        /** Stable scatter of n values read by read(i) into write(position, value), by their digit at shift */
+        template <typename V, typename Read, typename Write>
+        void radix_scatter(std::size_t n, unsigned int shift, std::size_t *offsets, Read read, Write write)
+        {
+            using key_t = radix_key<V>;
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const V v = read(i);
+
+                write(offsets[(key_t::key(v) >> shift) & (radix_buckets - 1)]++, v);
+            }
+        }
+
+        /**
+         * Least significant digit radix sort of [first, last)
+         *
+         * A first pass counts the digits of all the keys at once, and passes over digits which are the same for
+         * every element are skipped: sorting timestamps or identifiers sharing their high bytes costs fewer passes.
+         * Underlying values are scattered between two buffers, the range itself only being written by the last pass.
+         */
+        template <typename It>
+        void radix_sort(It first, It last)
+        {
+            using S = typename std::iterator_traits<It>::value_type;
+            using V = typename S::value_type;
+            using key_t = radix_key<V>;
+            constexpr std::size_t digits = sizeof(V) * 8 / radix_digit_bits;
+
+            const auto n = static_cast<std::size_t>(last - first);
+            auto counts = std::make_unique<std::size_t[][radix_buckets]>(digits);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto key = key_t::key(first[i].value());
+
+                for (std::size_t d = 0; d < digits; ++d)
+                    ++counts[d][(key >> radix_shift(d)) & (radix_buckets - 1)];
+            }
+
+            const auto first_key = key_t::key(first[0].value());
+            std::size_t active[digits];
+            std::size_t passes = 0;
+
+            for (std::size_t d = 0; d < digits; ++d) {
+                if (counts[d][(first_key >> radix_shift(d)) & (radix_buckets - 1)] == n)
+                    continue;
+
+                std::size_t offset = 0;
+
+                for (std::size_t b = 0; b < radix_buckets; ++b) {
+                    const std::size_t count = counts[d][b];
+
+                    counts[d][b] = offset;
+                    offset += count;
+                }
+                active[passes++] = d;
+            }
+            if (passes == 0)
+                return;
+
+            const std::unique_ptr<V[]> front(new V[n]);
+            const std::unique_ptr<V[]> back(passes > 2 ? new V[n] : nullptr);
+            const auto read_range = [first](std::size_t i) { return first[i].value(); };
+            const auto write_range = [first](std::size_t i, V v) { first[i] = S(v); };
+            const auto read = [](const V *buffer) { return [buffer](std::size_t i) { return buffer[i]; }; };
+            const auto write = [](V *buffer) { return [buffer](std::size_t i, V v) { buffer[i] = v; }; };
+
+            radix_scatter<V>(n, radix_shift(active[0]), counts[active[0]], read_range, write(front.get()));
+            for (std::size_t p = 1; p + 1 < passes; ++p) {
+                V *src = p % 2 ? front.get() : back.get();
+                V *dst = p % 2 ? back.get() : front.get();
+
+                radix_scatter<V>(n, radix_shift(active[p]), counts[active[p]], read(src), write(dst));
+            }
+            if (passes == 1) {
+                for (std::size_t i = 0; i < n; ++i)
+                    write_range(i, front[i]);
+            } else {
+                const std::size_t p = passes - 1;
+                const V *src = p % 2 ? front.get() : back.get();
+
+                radix_scatter<V>(n, radix_shift(active[p]), counts[active[p]], read(src), write_range);
+            }
+        }
+    }
+
+    /** Sorts [first, last) in ascending order, as std::sort does */
+    template <typename RandomIt>
+    void sort(RandomIt first, RandomIt last)
+    {
+        if constexpr (details::uses_radix_sort_v<RandomIt>) {
+            if (static_cast<std::size_t>(last - first) >= details::radix_sort_threshold) {
+                details::radix_sort(first, last);
+                return;
+            }
+        }
+        std::sort(first, last);
+    }
+
+    /** Sorts [first, last) in ascending order, keeping equivalent elements in order, as std::stable_sort does */
+    template <typename RandomIt>
+    void stable_sort(RandomIt first, RandomIt last)
+    {
+        if constexpr (details::uses_radix_sort_v<RandomIt>) {
+            if (static_cast<std::size_t>(last - first) >= details::radix_sort_threshold) {
+                details::radix_sort(first, last);
+                return;
+            }
+        }
+        std::stable_sort(first, last);
+    }
+
+    /** First element of the sorted range [first, last) which is not less than value, as std::lower_bound does */
+    template <typename ForwardIt, typename U>
+    ForwardIt lower_bound(ForwardIt first, ForwardIt last, const U &value)
+    {
+        if constexpr (details::uses_branchless_search_v<ForwardIt>) {
+            auto n = last - first;
+
+            if (n == 0)
+                return first;
+            /* The range keeps containing the result, and only its length depends on the comparisons */
+            while (n > 1) {
+                const auto half = n / 2;
+
+                first = first[half] < value ? first + half : first;
+                n -= half;
+            }
+            return first + (*first < value);
+        } else {
+            return std::lower_bound(first, last, value);
+        }
+    }
+
+    /** First element of the sorted range [first, last) which is greater than value, as std::upper_bound does */
+    template <typename ForwardIt, typename U>
+    ForwardIt upper_bound(ForwardIt first, ForwardIt last, const U &value)
+    {
+        if constexpr (details::uses_branchless_search_v<ForwardIt>) {
+            auto n = last - first;
+
+            if (n == 0)
+                return first;
+            while (n > 1) {
+                const auto half = n / 2;
+
+                first = value < first[half] ? first : first + half;
+                n -= half;
+            }
+            return first + !(value < *first);
+        } else {
+            return std::upper_bound(first, last, value);
+        }
+    }
+}
+
+#endif /* !STRONG_TYPE_ALGORITHM_HPP */
@@ -0,0 +1,230 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_ATOMIC_HPP
+#define STRONG_TYPE_ATOMIC_HPP
+
+#include <atomic>
+#include <type_traits>
+#include <st/traits.hpp>
+
+namespace st
+{
+    namespace details
+    {
+        /** Whether the strong type S has the binary trait Trait with operand U */
+        template <template <typename ...> class Trait, typename S, typename U>
+        inline constexpr bool has_binary_trait_v = std::is_base_of_v<Trait<S, U>, S>;
+
+        template <template <typename ...> class Trait, template <typename ...> class AssignTrait, typename S,
+            typename U>
+        inline constexpr bool has_atomic_operation_v =
+            std::is_integral_v<typename S::value_type> &&
+            (has_binary_trait_v<Trait, S, U> || has_binary_trait_v<AssignTrait, S, U>);
+    }
+
+    /**
+     * Atomic object holding a strong type S
+     *
+     * load, store and exchange are always available. Other operations are only available when S has the matching
+     * traits: fetch_add and += require addable or add_assignable, fetch_or and |= require bitwise_orable or
+     * bitwise_or_assignable, ++ requires incrementable, compare_exchange requires equality_comparable, and so on.
+     * Arithmetic and bitwise operations are only provided for integral underlying types, which are required to be
+     * always lock-free.
+     */
+    template <typename S>
+    class atomic
+    {
+        static_assert(is_strong_type_v<S>, "st::atomic can only hold strong types");
+
+        using value_type_t = typename S::value_type;
+
+        static_assert(std::is_trivially_copyable_v<value_type_t>,
+                      "st::atomic requires a trivially copyable underlying type");
+        static_assert(!std::is_integral_v<value_type_t> || std::atomic<value_type_t>::is_always_lock_free,
+                      "atomic strong types wrapping an integral type must be lock-free");
+
+    public:
+        using value_type = S;
+
+        static constexpr bool is_always_lock_free = std::atomic<value_type_t>::is_always_lock_free;
+
+        constexpr atomic() noexcept : _value(value_type_t())
+        {
+        }
+
+        constexpr atomic(const S &desired) noexcept : _value(desired.value())
+        {
+        }
+
+        atomic(const atomic &) = delete;
+
+        atomic &operator=(const atomic &) = delete;
+
+        bool is_lock_free() const noexcept
+        {
+            return _value.is_lock_free();
+        }
+
+        S load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+        {
+            return S(_value.load(order));
+        }
+
+        void store(const S &desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            _value.store(desired.value(), order);
+        }
+
+        S exchange(const S &desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return S(_value.exchange(desired.value(), order));
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        bool compare_exchange_weak(S &expected, const S &desired, std::memory_order success,
+                                   std::memory_order failure) noexcept
+        {
+            return _value.compare_exchange_weak(expected.value(), desired.value(), success, failure);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        bool compare_exchange_weak(S &expected, const S &desired,
+                                   std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return _value.compare_exchange_weak(expected.value(), desired.value(), order);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        bool compare_exchange_strong(S &expected, const S &desired, std::memory_order success,
+                                     std::memory_order failure) noexcept
+        {
+            return _value.compare_exchange_strong(expected.value(), desired.value(), success, failure);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        bool compare_exchange_strong(S &expected, const S &desired,
+                                     std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return _value.compare_exchange_strong(expected.value(), desired.value(), order);
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::addable, traits::add_assignable, S, U>
+        >>
+        S fetch_add(const U &arg, std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return S(_value.fetch_add(static_cast<value_type_t>(unwrap(arg)), order));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::subtractable, traits::subtract_assignable, S, U>
+        >>
+        S fetch_sub(const U &arg, std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return S(_value.fetch_sub(static_cast<value_type_t>(unwrap(arg)), order));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::bitwise_orable, traits::bitwise_or_assignable, S, U>
+        >>
+        S fetch_or(const U &arg, std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return S(_value.fetch_or(static_cast<value_type_t>(unwrap(arg)), order));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::bitwise_andable, traits::bitwise_and_assignable, S, U>
+        >>
+        S fetch_and(const U &arg, std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return S(_value.fetch_and(static_cast<value_type_t>(unwrap(arg)), order));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::bitwise_xorable, traits::bitwise_xor_assignable, S, U>
+        >>
+        S fetch_xor(const U &arg, std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return S(_value.fetch_xor(static_cast<value_type_t>(unwrap(arg)), order));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::addable, traits::add_assignable, S, U>
+        >>
+        S operator+=(const U &arg) noexcept
+        {
+            return S(_value += static_cast<value_type_t>(unwrap(arg)));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::subtractable, traits::subtract_assignable, S, U>
+        >>
+        S operator-=(const U &arg) noexcept
+        {
+            return S(_value -= static_cast<value_type_t>(unwrap(arg)));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::bitwise_orable, traits::bitwise_or_assignable, S, U>
+        >>
+        S operator|=(const U &arg) noexcept
+        {
+            return S(_value |= static_cast<value_type_t>(unwrap(arg)));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::bitwise_andable, traits::bitwise_and_assignable, S, U>
+        >>
+        S operator&=(const U &arg) noexcept
+        {
+            return S(_value &= static_cast<value_type_t>(unwrap(arg)));
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::bitwise_xorable, traits::bitwise_xor_assignable, S, U>
+        >>
+        S operator^=(const U &arg) noexcept
+        {
+            return S(_value ^= static_cast<value_type_t>(unwrap(arg)));
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<
+            std::is_integral_v<value_type_t> && std::is_base_of_v<traits::incrementable<_S>, _S>
+        >>
+        S operator++() noexcept
+        {
+            return S(++_value);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<
+            std::is_integral_v<value_type_t> && std::is_base_of_v<traits::incrementable<_S>, _S>
+        >>
+        S operator++(int) noexcept
+        {
+            return S(_value++);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<
+            std::is_integral_v<value_type_t> && std::is_base_of_v<traits::decrementable<_S>, _S>
+        >>
+        S operator--() noexcept
+        {
+            return S(--_value);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<
+            std::is_integral_v<value_type_t> && std::is_base_of_v<traits::decrementable<_S>, _S>
+        >>
+        S operator--(int) noexcept
+        {
+            return S(_value--);
+        }
+
+    private:
+        std::atomic<value_type_t> _value;
+    };
+}
+
+#endif /* !STRONG_TYPE_ATOMIC_HPP */
@@ -0,0 +1,813 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_BATCH_HPP
+#define STRONG_TYPE_BATCH_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <st/traits.hpp>
+#include <st/span.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRONG_TYPE_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#define STRONG_TYPE_BATCH_SSE41
+#include <smmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define STRONG_TYPE_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * Element-wise operations over contiguous ranges of strong types
+ *
+ * Every operation is only available if the strong type carries the corresponding trait, and behaves as if that
+ * trait's operator was applied to each element in turn. When the strong type is layout-compatible with an
+ * arithmetic underlying type, explicit SSE2 / AVX2 kernels are used for the bulk of the range, with a scalar loop
+ * handling the remaining elements.
+ *
+ * Reductions over floating point values accumulate in several lanes, and may therefore round differently from a
+ * sequential loop. Results of min() / max() are unspecified if the range contains NaNs.
+ */
+namespace st::batch
+{
+    namespace details
+    {
+        template <typename Range>
+        using element_t = std::remove_pointer_t<decltype(std::data(std::declval<Range &>()))>;
+
+        template <typename Range>
+        using strong_t = std::remove_cv_t<element_t<Range>>;
+
+        template <typename V>
+        inline constexpr bool is_vectorizable_v =
+            std::is_arithmetic_v<V> && !std::is_same_v<V, bool> &&
+            (std::is_integral_v<V> || std::is_same_v<V, float> || std::is_same_v<V, double>);
+
+        template <typename S>
+        inline constexpr bool uses_kernels_v = is_layout_compatible_v<S> && is_vectorizable_v<typename S::value_type>;
+
+        template <typename S>
+        inline const typename S::value_type *raw(const S *p) noexcept
+        {
+            return reinterpret_cast<const typename S::value_type *>(p);
+        }
+
+        template <typename S>
+        inline typename S::value_type *raw(S *p) noexcept
+        {
+            return reinterpret_cast<typename S::value_type *>(p);
+        }
+
+#if defined(STRONG_TYPE_BATCH_SSE2)
+        template <typename V>
+        struct sse2_reg
+        {
+            using type = __m128i;
+        };
+
+        template <>
+        struct sse2_reg<float>
+        {
+            using type = __m128;
+        };
+
+        template <>
+        struct sse2_reg<double>
+        {
+            using type = __m128d;
+        };
+
+        struct sse2
+        {
+            template <typename V>
+            using reg = typename sse2_reg<V>::type;
+
+            template <typename V>
+            static constexpr std::size_t lanes = 16 / sizeof(V);
+
+            template <typename V>
+            static reg<V> load(const V *p) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm_loadu_ps(p);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm_loadu_pd(p);
+                else
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            }
+
+            template <typename V>
+            static void store(V *p, reg<V> r) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    _mm_storeu_ps(p, r);
+                else if constexpr (std::is_same_v<V, double>)
+                    _mm_storeu_pd(p, r);
+                else
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), r);
+            }
+
+            template <typename V>
+            static reg<V> broadcast(V v) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm_set1_ps(v);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm_set1_pd(v);
+                else if constexpr (sizeof(V) == 1)
+                    return _mm_set1_epi8(static_cast<char>(v));
+                else if constexpr (sizeof(V) == 2)
+                    return _mm_set1_epi16(static_cast<short>(v));
+                else if constexpr (sizeof(V) == 4)
+                    return _mm_set1_epi32(static_cast<int>(v));
+                else
+                    return _mm_set1_epi64x(static_cast<long long>(v));
+            }
+
+            template <typename V>
+            static constexpr bool has_add = true;
+
+            template <typename V>
+            static reg<V> add(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm_add_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm_add_pd(a, b);
+                else if constexpr (sizeof(V) == 1)
+                    return _mm_add_epi8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm_add_epi16(a, b);
+                else if constexpr (sizeof(V) == 4)
+                    return _mm_add_epi32(a, b);
+                else
+                    return _mm_add_epi64(a, b);
+            }
+
+            template <typename V>
+            static reg<V> sub(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm_sub_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm_sub_pd(a, b);
+                else if constexpr (sizeof(V) == 1)
+                    return _mm_sub_epi8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm_sub_epi16(a, b);
+                else if constexpr (sizeof(V) == 4)
+                    return _mm_sub_epi32(a, b);
+                else
+                    return _mm_sub_epi64(a, b);
+            }
+
+            template <typename V>
+            static constexpr bool has_mul = std::is_floating_point_v<V> || sizeof(V) == 2
+#if defined(STRONG_TYPE_BATCH_SSE41)
+                                            || sizeof(V) == 4
+#endif
+            ;
+
+            template <typename V>
+            static reg<V> mul(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm_mul_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm_mul_pd(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm_mullo_epi16(a, b);
+#if defined(STRONG_TYPE_BATCH_SSE41)
+                else
+                    return _mm_mullo_epi32(a, b);
+#endif
+            }
+
+            template <typename V>
+            static constexpr bool has_minmax = std::is_floating_point_v<V> ||
+                                               (std::is_same_v<V, std::int16_t> || std::is_same_v<V, std::uint8_t>)
+#if defined(STRONG_TYPE_BATCH_SSE41)
+                                               || (sizeof(V) <= 4)
+#endif
+            ;
+
+            template <typename V>
+            static reg<V> min(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm_min_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm_min_pd(a, b);
+                else if constexpr (sizeof(V) == 1 && std::is_unsigned_v<V>)
+                    return _mm_min_epu8(a, b);
+                else if constexpr (sizeof(V) == 2 && std::is_signed_v<V>)
+                    return _mm_min_epi16(a, b);
+#if defined(STRONG_TYPE_BATCH_SSE41)
+                else if constexpr (sizeof(V) == 1)
+                    return _mm_min_epi8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm_min_epu16(a, b);
+                else if constexpr (std::is_signed_v<V>)
+                    return _mm_min_epi32(a, b);
+                else
+                    return _mm_min_epu32(a, b);
+#endif
+            }
+
+            template <typename V>
+            static reg<V> max(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm_max_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm_max_pd(a, b);
+                else if constexpr (sizeof(V) == 1 && std::is_unsigned_v<V>)
+                    return _mm_max_epu8(a, b);
+                else if constexpr (sizeof(V) == 2 && std::is_signed_v<V>)
+                    return _mm_max_epi16(a, b);
+#if defined(STRONG_TYPE_BATCH_SSE41)
+                else if constexpr (sizeof(V) == 1)
+                    return _mm_max_epi8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm_max_epu16(a, b);
+                else if constexpr (std::is_signed_v<V>)
+                    return _mm_max_epi32(a, b);
+                else
+                    return _mm_max_epu32(a, b);
+#endif
+            }
+        };
+#endif
+
+#if defined(STRONG_TYPE_BATCH_AVX2)
+        template <typename V>
+        struct avx2_reg
+        {
+            using type = __m256i;
+        };
+
+        template <>
+        struct avx2_reg<float>
+        {
+            using type = __m256;
+        };
+
+        template <>
+        struct avx2_reg<double>
+        {
+            using type = __m256d;
+        };
+
+        struct avx2
+        {
+            template <typename V>
+            using reg = typename avx2_reg<V>::type;
+
+            template <typename V>
+            static constexpr std::size_t lanes = 32 / sizeof(V);
+
+            template <typename V>
+            static reg<V> load(const V *p) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm256_loadu_ps(p);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm256_loadu_pd(p);
+                else
+                    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            }
+
+            template <typename V>
+            static void store(V *p, reg<V> r) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    _mm256_storeu_ps(p, r);
+                else if constexpr (std::is_same_v<V, double>)
+                    _mm256_storeu_pd(p, r);
+                else
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), r);
+            }
+
+            template <typename V>
+            static reg<V> broadcast(V v) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm256_set1_ps(v);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm256_set1_pd(v);
+                else if constexpr (sizeof(V) == 1)
+                    return _mm256_set1_epi8(static_cast<char>(v));
+                else if constexpr (sizeof(V) == 2)
+                    return _mm256_set1_epi16(static_cast<short>(v));
+                else if constexpr (sizeof(V) == 4)
+                    return _mm256_set1_epi32(static_cast<int>(v));
+                else
+                    return _mm256_set1_epi64x(static_cast<long long>(v));
+            }
+
+            template <typename V>
+            static constexpr bool has_add = true;
+
+            template <typename V>
+            static reg<V> add(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm256_add_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm256_add_pd(a, b);
+                else if constexpr (sizeof(V) == 1)
+                    return _mm256_add_epi8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm256_add_epi16(a, b);
+                else if constexpr (sizeof(V) == 4)
+                    return _mm256_add_epi32(a, b);
+                else
+                    return _mm256_add_epi64(a, b);
+            }
+
+            template <typename V>
+            static reg<V> sub(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm256_sub_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm256_sub_pd(a, b);
+                else if constexpr (sizeof(V) == 1)
+                    return _mm256_sub_epi8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm256_sub_epi16(a, b);
+                else if constexpr (sizeof(V) == 4)
+                    return _mm256_sub_epi32(a, b);
+                else
+                    return _mm256_sub_epi64(a, b);
+            }
+
+            template <typename V>
+            static constexpr bool has_mul = std::is_floating_point_v<V> || sizeof(V) == 2 || sizeof(V) == 4;
+
+            template <typename V>
+            static reg<V> mul(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm256_mul_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm256_mul_pd(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return _mm256_mullo_epi16(a, b);
+                else
+                    return _mm256_mullo_epi32(a, b);
+            }
+
+            template <typename V>
+            static constexpr bool has_minmax = std::is_floating_point_v<V> || sizeof(V) <= 4;
+
+            template <typename V>
+            static reg<V> min(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm256_min_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm256_min_pd(a, b);
+                else if constexpr (sizeof(V) == 1)
+                    return std::is_signed_v<V> ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return std::is_signed_v<V> ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+                else
+                    return std::is_signed_v<V> ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+            }
+
+            template <typename V>
+            static reg<V> max(reg<V> a, reg<V> b) noexcept
+            {
+                if constexpr (std::is_same_v<V, float>)
+                    return _mm256_max_ps(a, b);
+                else if constexpr (std::is_same_v<V, double>)
+                    return _mm256_max_pd(a, b);
+                else if constexpr (sizeof(V) == 1)
+                    return std::is_signed_v<V> ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b);
+                else if constexpr (sizeof(V) == 2)
+                    return std::is_signed_v<V> ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+                else
+                    return std::is_signed_v<V> ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+            }
+        };
+#endif
+
+        struct add_op
+        {
+            template <typename Isa, typename V>
+            static constexpr bool supported = Isa::template has_add<V>;
+
+            template <typename Isa, typename V>
+            static auto apply(typename Isa::template reg<V> a, typename Isa::template reg<V> b) noexcept
+            {
+                return Isa::template add<V>(a, b);
+            }
+        };
+
+        struct sub_op
+        {
+            template <typename Isa, typename V>
+            static constexpr bool supported = Isa::template has_add<V>;
+
+            template <typename Isa, typename V>
+            static auto apply(typename Isa::template reg<V> a, typename Isa::template reg<V> b) noexcept
+            {
+                return Isa::template sub<V>(a, b);
+            }
+        };
+
+        struct mul_op
+        {
+            template <typename Isa, typename V>
+            static constexpr bool supported = Isa::template has_mul<V>;
+
+            template <typename Isa, typename V>
+            static auto apply(typename Isa::template reg<V> a, typename Isa::template reg<V> b) noexcept
+            {
+                return Isa::template mul<V>(a, b);
+            }
+        };
+
+        struct min_op
+        {
+            template <typename Isa, typename V>
+            static constexpr bool supported = Isa::template has_minmax<V>;
+
+            template <typename Isa, typename V>
+            static auto apply(typename Isa::template reg<V> a, typename Isa::template reg<V> b) noexcept
+            {
+                return Isa::template min<V>(a, b);
+            }
+        };
+
+        struct max_op
+        {
+            template <typename Isa, typename V>
+            static constexpr bool supported = Isa::template has_minmax<V>;
+
+            template <typename Isa, typename V>
+            static auto apply(typename Isa::template reg<V> a, typename Isa::template reg<V> b) noexcept
+            {
+                return Isa::template max<V>(a, b);
+            }
+        };
+
+        template <typename Op, typename Isa, typename V>
+        inline std::size_t binary_kernel(const V *lhs, const V *rhs, V *out, std::size_t n, std::size_t i) noexcept
+        {
+            if constexpr (Op::template supported<Isa, V>) {
+                constexpr std::size_t lanes = Isa::template lanes<V>;
+
+                for (; i + lanes <= n; i += lanes) {
+                    auto r = Op::template apply<Isa, V>(Isa::load(lhs + i), Isa::load(rhs + i));
+                    Isa::template store<V>(out + i, r);
+                }
+            }
+            return i;
+        }
+
+        /** Applies Op to as many elements as possible using vector registers, and returns the number processed */
+        template <typename Op, typename V>
+        inline std::size_t binary([[maybe_unused]] const V *lhs, [[maybe_unused]] const V *rhs,
+                                  [[maybe_unused]] V *out, [[maybe_unused]] std::size_t n) noexcept
+        {
+            std::size_t i = 0;
+
+#if defined(STRONG_TYPE_BATCH_AVX2)
+            i = binary_kernel<Op, avx2>(lhs, rhs, out, n, i);
+#endif
+#if defined(STRONG_TYPE_BATCH_SSE2)
+            i = binary_kernel<Op, sse2>(lhs, rhs, out, n, i);
+#endif
+            return i;
+        }
+
+        template <typename Op, typename Isa, typename V>
+        inline std::size_t broadcast_kernel(const V *lhs, V rhs, V *out, std::size_t n, std::size_t i) noexcept
+        {
+            if constexpr (Op::template supported<Isa, V>) {
+                constexpr std::size_t lanes = Isa::template lanes<V>;
+                const auto factor = Isa::broadcast(rhs);
+
+                for (; i + lanes <= n; i += lanes) {
+                    Isa::template store<V>(out + i, Op::template apply<Isa, V>(Isa::load(lhs + i), factor));
+                }
+            }
+            return i;
+        }
+
+        template <typename Op, typename V>
+        inline std::size_t broadcast([[maybe_unused]] const V *lhs, [[maybe_unused]] V rhs,
+                                     [[maybe_unused]] V *out, [[maybe_unused]] std::size_t n) noexcept
+        {
+            std::size_t i = 0;
+
+#if defined(STRONG_TYPE_BATCH_AVX2)
+            i = broadcast_kernel<Op, avx2>(lhs, rhs, out, n, i);
+#endif
+#if defined(STRONG_TYPE_BATCH_SSE2)
+            i = broadcast_kernel<Op, sse2>(lhs, rhs, out, n, i);
+#endif
+            return i;
+        }
+
+/*
+ * GCC warns about the first vector load of reduce_kernel() when it is inlined for a range shorter than a register, as
+ * it does not prune the branch guarded by n >= lanes before checking array bounds
+ */
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+
+        template <typename Op, typename Isa, typename V, typename Fold>
+        inline std::size_t reduce_kernel(const V *in, std::size_t n, V &acc, bool &has_acc, Fold fold) noexcept
+        {
+            constexpr std::size_t lanes = Isa::template lanes<V>;
+            std::size_t i = 0;
+
+            if constexpr (Op::template supported<Isa, V>) {
+                if (n >= lanes) {
+                    auto r = Isa::load(in);
+
+                    for (i = lanes; i + lanes <= n; i += lanes) {
+                        r = Op::template apply<Isa, V>(r, Isa::load(in + i));
+                    }
+
+                    V tmp[lanes];
+                    Isa::template store<V>(tmp, r);
+                    for (std::size_t lane = 0; lane < lanes; ++lane) {
+                        acc = has_acc ? fold(acc, tmp[lane]) : tmp[lane];
+                        has_acc = true;
+                    }
+                }
+            }
+            return i;
+        }
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+        /**
+         * Reduces as many elements as possible using vector registers
+         *
+         * Returns the number of elements processed. If any, their reduction is stored in acc.
+         */
+        template <typename Op, typename V, typename Fold>
+        inline std::size_t reduce([[maybe_unused]] const V *in, [[maybe_unused]] std::size_t n,
+                                  [[maybe_unused]] V &acc, [[maybe_unused]] Fold fold) noexcept
+        {
+            std::size_t i = 0;
+            [[maybe_unused]] bool has_acc = false;
+
+#if defined(STRONG_TYPE_BATCH_AVX2)
+            i = reduce_kernel<Op, avx2>(in, n, acc, has_acc, fold);
+#endif
+#if defined(STRONG_TYPE_BATCH_SSE2)
+            if (i == 0)
+                i = reduce_kernel<Op, sse2>(in, n, acc, has_acc, fold);
+#endif
+            return i;
+        }
+
+        template <typename Lhs, typename Rhs, typename Out>
+        inline void check_sizes([[maybe_unused]] const Lhs &lhs, [[maybe_unused]] const Rhs &rhs,
+                                [[maybe_unused]] const Out &out) noexcept
+        {
+            assert(std::size(lhs) == std::size(rhs) && std::size(out) >= std::size(lhs));
+        }
+    }
+
+    /** out[i] = lhs[i] + rhs[i] */
+    template <typename LhsRange, typename RhsRange, typename OutRange>
+    inline void add(const LhsRange &lhs, const RhsRange &rhs, OutRange &&out) noexcept
+    {
+        using S = details::strong_t<const LhsRange>;
+
+        static_assert(std::is_same_v<S, details::strong_t<const RhsRange>>, "operands must have the same type");
+        static_assert(std::is_same_v<S, details::element_t<OutRange>>, "output must be a mutable range of operands");
+        static_assert(std::is_base_of_v<traits::addable<S>, S>, "batch::add requires the addable trait");
+
+        details::check_sizes(lhs, rhs, out);
+
+        const S *a = std::data(lhs);
+        const S *b = std::data(rhs);
+        S *o = std::data(out);
+        const std::size_t n = std::size(lhs);
+        std::size_t i = 0;
+
+        if constexpr (details::uses_kernels_v<S>) {
+            i = details::binary<details::add_op>(details::raw(a), details::raw(b), details::raw(o), n);
+        }
+        for (; i < n; ++i) {
+            o[i] = a[i] + b[i];
+        }
+    }
+
+    /** out[i] = lhs[i] - rhs[i] */
+    template <typename LhsRange, typename RhsRange, typename OutRange>
+    inline void sub(const LhsRange &lhs, const RhsRange &rhs, OutRange &&out) noexcept
+    {
+        using S = details::strong_t<const LhsRange>;
+
+        static_assert(std::is_same_v<S, details::strong_t<const RhsRange>>, "operands must have the same type");
+        static_assert(std::is_same_v<S, details::element_t<OutRange>>, "output must be a mutable range of operands");
+        static_assert(std::is_base_of_v<traits::subtractable<S>, S>, "batch::sub requires the subtractable trait");
+
+        details::check_sizes(lhs, rhs, out);
+
+        const S *a = std::data(lhs);
+        const S *b = std::data(rhs);
+        S *o = std::data(out);
+        const std::size_t n = std::size(lhs);
+        std::size_t i = 0;
+
+        if constexpr (details::uses_kernels_v<S>) {
+            i = details::binary<details::sub_op>(details::raw(a), details::raw(b), details::raw(o), n);
+        }
+        for (; i < n; ++i) {
+            o[i] = a[i] - b[i];
+        }
+    }
+
+    /** out[i] = in[i] * factor */
+    template <typename InRange, typename FactorT, typename OutRange>
+    inline void scale(const InRange &in, const FactorT &factor, OutRange &&out) noexcept
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_same_v<S, details::element_t<OutRange>>, "output must be a mutable range of operands");
+        static_assert(std::is_base_of_v<traits::multiplicable<S, FactorT>, S>,
+                      "batch::scale requires the multiplicable_with trait for the given factor type");
+
+        details::check_sizes(in, in, out);
+
+        const S *a = std::data(in);
+        S *o = std::data(out);
+        const std::size_t n = std::size(in);
+        std::size_t i = 0;
+
+        if constexpr (details::uses_kernels_v<S>) {
+            using V = typename S::value_type;
+
+            if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(unwrap(factor))>>, V>) {
+                i = details::broadcast<details::mul_op>(details::raw(a), unwrap(factor), details::raw(o), n);
+            }
+        }
+        for (; i < n; ++i) {
+            o[i] = a[i] * factor;
+        }
+    }
+
+    /** Sum of all the elements of the range, starting from init */
+    template <typename InRange, typename S = details::strong_t<const InRange>>
+    inline S sum(const InRange &in, S init = S()) noexcept
+    {
+        static_assert(std::is_same_v<S, details::strong_t<const InRange>>, "init must have the type of the elements");
+        static_assert(std::is_base_of_v<traits::addable<S>, S>, "batch::sum requires the addable trait");
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        std::size_t i = 0;
+
+        if constexpr (details::uses_kernels_v<S>) {
+            using V = typename S::value_type;
+            V partial{};
+
+            i = details::reduce<details::add_op>(details::raw(a), n, partial, [](V x, V y) {
+                return static_cast<V>(x + y);
+            });
+            if (i != 0)
+                init = init + S(partial);
+        }
+        for (; i < n; ++i) {
+            init = init + a[i];
+        }
+        return init;
+    }
+
+    /** Smallest element of a non-empty range */
+    template <typename InRange>
+    inline details::strong_t<const InRange> min(const InRange &in) noexcept
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_base_of_v<traits::orderable<S>, S>, "batch::min requires the orderable trait");
+        assert(std::size(in) != 0);
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        S best = a[0];
+        std::size_t i = 1;
+
+        if constexpr (details::uses_kernels_v<S>) {
+            using V = typename S::value_type;
+            V partial{};
+
+            i = details::reduce<details::min_op>(details::raw(a), n, partial, [](V x, V y) {
+                return y < x ? y : x;
+            });
+            if (i != 0)
+                best = S(partial);
+            else
+                i = 1;
+        }
+        for (; i < n; ++i) {
+            if (a[i] < best)
+                best = a[i];
+        }
+        return best;
+    }
+
+    /** Largest element of a non-empty range */
+    template <typename InRange>
+    inline details::strong_t<const InRange> max(const InRange &in) noexcept
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_base_of_v<traits::orderable<S>, S>, "batch::max requires the orderable trait");
+        assert(std::size(in) != 0);
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        S best = a[0];
+        std::size_t i = 1;
+
+        if constexpr (details::uses_kernels_v<S>) {
+            using V = typename S::value_type;
+            V partial{};
+
+            i = details::reduce<details::max_op>(details::raw(a), n, partial, [](V x, V y) {
+                return x < y ? y : x;
+            });
+            if (i != 0)
+                best = S(partial);
+            else
+                i = 1;
+        }
+        for (; i < n; ++i) {
+            if (best < a[i])
+                best = a[i];
+        }
+        return best;
+    }
+
+    /** out[i] = lhs[i] == rhs[i] */
+    template <typename LhsRange, typename RhsRange, typename OutRange>
+    inline void equal(const LhsRange &lhs, const RhsRange &rhs, OutRange &&out) noexcept
+    {
+        using S = details::strong_t<const LhsRange>;
+
+        static_assert(std::is_same_v<S, details::strong_t<const RhsRange>>, "operands must have the same type");
+        static_assert(std::is_same_v<bool, details::element_t<OutRange>>, "output must be a mutable range of bool");
+        static_assert(std::is_base_of_v<traits::equality_comparable<S>, S>,
+                      "batch::equal requires the equality_comparable trait");
+
+        details::check_sizes(lhs, rhs, out);
+
+        const S *a = std::data(lhs);
+        const S *b = std::data(rhs);
+        bool *o = std::data(out);
+        const std::size_t n = std::size(lhs);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            o[i] = a[i] == b[i];
+        }
+    }
+
+    /** out[i] = lhs[i] < rhs[i] */
+    template <typename LhsRange, typename RhsRange, typename OutRange>
+    inline void less(const LhsRange &lhs, const RhsRange &rhs, OutRange &&out) noexcept
+    {
+        using S = details::strong_t<const LhsRange>;
+
+        static_assert(std::is_same_v<S, details::strong_t<const RhsRange>>, "operands must have the same type");
+        static_assert(std::is_same_v<bool, details::element_t<OutRange>>, "output must be a mutable range of bool");
+        static_assert(std::is_base_of_v<traits::orderable<S>, S>, "batch::less requires the orderable trait");
+
+        details::check_sizes(lhs, rhs, out);
+
+        const S *a = std::data(lhs);
+        const S *b = std::data(rhs);
+        bool *o = std::data(out);
+        const std::size_t n = std::size(lhs);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            o[i] = a[i] < b[i];
+        }
+    }
+}
+
+#endif /* !STRONG_TYPE_BATCH_HPP */
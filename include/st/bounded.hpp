@@ -0,0 +1,544 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_BOUNDED_HPP
+#define STRONG_TYPE_BOUNDED_HPP
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <st/traits.hpp>
+#include <st/overflow.hpp>
+
+namespace st
+{
+    namespace details
+    {
+        template <typename T, std::intmax_t Min, std::intmax_t Max>
+        inline constexpr bool fits_v =
+            Min >= static_cast<std::intmax_t>(std::numeric_limits<T>::min()) &&
+            (Max < 0 || static_cast<std::uintmax_t>(Max) <= static_cast<std::uintmax_t>(std::numeric_limits<T>::max()));
+
+        /** Narrowest integral type holding all values of [Min, Max], unsigned if Min is not negative */
+        template <std::intmax_t Min, std::intmax_t Max>
+        struct bounded_value
+        {
+            template <typename Small, typename Medium, typename Large, typename Huge>
+            using narrowest = std::conditional_t<fits_v<Small, Min, Max>, Small,
+                std::conditional_t<fits_v<Medium, Min, Max>, Medium,
+                    std::conditional_t<fits_v<Large, Min, Max>, Large, Huge>>>;
+
+            using type = std::conditional_t<
+                (Min >= 0),
+                narrowest<std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>,
+                narrowest<std::int8_t, std::int16_t, std::int32_t, std::int64_t>
+            >;
+        };
+
+        template <std::intmax_t Min, std::intmax_t Max>
+        using bounded_value_t = typename bounded_value<Min, Max>::type;
+
+        template <std::intmax_t Min, std::intmax_t Max, typename V>
+        constexpr bool in_bounds(V v) noexcept
+        {
+            if constexpr (std::is_signed_v<V>)
+                return static_cast<std::intmax_t>(v) >= Min && static_cast<std::intmax_t>(v) <= Max;
+            else
+                return Max >= 0 &&
+                       (Min <= 0 || static_cast<std::uintmax_t>(v) >= static_cast<std::uintmax_t>(Min)) &&
+                       static_cast<std::uintmax_t>(v) <= static_cast<std::uintmax_t>(Max);
+        }
+
+        template <typename T, std::intmax_t Min, std::intmax_t Max, typename V>
+        constexpr T check_bounds(V v)
+        {
+            if (!in_bounds<Min, Max>(v))
+                throw std::out_of_range("st::bounded: value out of bounds");
+            return static_cast<T>(v);
+        }
+
+        /** Bounds of the result of an operation */
+        struct result_bounds
+        {
+            std::intmax_t min;
+            std::intmax_t max;
+        };
+
+        /** Reached while computing bounds in a constant expression, which makes the program ill-formed */
+        constexpr void bounds_overflow(bool overflowed)
+        {
+            if (overflowed)
+                throw std::overflow_error("the bounds of the result do not fit in std::intmax_t");
+        }
+
+        constexpr result_bounds add_bounds(std::intmax_t min1, std::intmax_t max1,
+                                           std::intmax_t min2, std::intmax_t max2)
+        {
+            result_bounds ret{};
+
+            bounds_overflow(add_overflow(min1, min2, ret.min) | add_overflow(max1, max2, ret.max));
+            return ret;
+        }
+
+        constexpr result_bounds sub_bounds(std::intmax_t min1, std::intmax_t max1,
+                                           std::intmax_t min2, std::intmax_t max2)
+        {
+            result_bounds ret{};
+
+            bounds_overflow(sub_overflow(min1, max2, ret.min) | sub_overflow(max1, min2, ret.max));
+            return ret;
+        }
+
+        constexpr result_bounds mul_bounds(std::intmax_t min1, std::intmax_t max1,
+                                           std::intmax_t min2, std::intmax_t max2)
+        {
+            std::intmax_t p[4]{};
+
+            bounds_overflow(mul_overflow(min1, min2, p[0]) | mul_overflow(min1, max2, p[1]) |
+                            mul_overflow(max1, min2, p[2]) | mul_overflow(max1, max2, p[3]));
+
+            result_bounds ret{p[0], p[0]};
+
+            for (auto v : p) {
+                ret.min = v < ret.min ? v : ret.min;
+                ret.max = v > ret.max ? v : ret.max;
+            }
+            return ret;
+        }
+    }
+
+    /**
+     * Storage of bounded strong types, validating their value
+     *
+     * Construction from a value outside of [Min, Max] throws std::out_of_range. The value is only accessible through
+     * const value() overloads, so that it cannot be set out of bounds: operations modifying it build a new, validated
+     * value instead. Default construction yields 0 if it is within bounds, Min otherwise.
+     */
+    template <typename T, std::intmax_t Min, std::intmax_t Max>
+    class bounded_storage : public type_base<T>
+    {
+        using base_type = type_base<T>;
+
+        static_assert(Min <= Max, "the bounds of a bounded strong type must not be empty");
+        static_assert(details::fits_v<T, Min, Max>, "the underlying type cannot hold all values within bounds");
+
+    public:
+        constexpr bounded_storage() noexcept : base_type(static_cast<T>(Min <= 0 && Max >= 0 ? 0 : Min))
+        {
+        }
+
+        template <typename V, typename = std::enable_if_t<details::is_checkable_v<V>>>
+        explicit constexpr bounded_storage(V v) : base_type(details::check_bounds<T, Min, Max>(v))
+        {
+        }
+
+        constexpr const T &value() const & noexcept
+        {
+            return base_type::value();
+        }
+
+        constexpr const T &&value() const && noexcept
+        {
+            return std::move(base_type::value());
+        }
+    };
+
+    namespace traits
+    {
+        template <typename T, std::intmax_t Min, std::intmax_t Max>
+        struct bounds
+        {
+            static constexpr const std::intmax_t min_value = Min;
+            static constexpr const std::intmax_t max_value = Max;
+        };
+    }
+
+    /** Trait restricting the values of a strong type to [Min, Max], see bounded */
+    template <std::intmax_t Min, std::intmax_t Max>
+    struct bounds
+    {
+        template <typename T>
+        using type = traits::bounds<T, Min, Max>;
+
+        template <typename T>
+        using storage = bounded_storage<T, Min, Max>;
+    };
+
+    /**
+     * Strong type holding an integer within [Min, Max], stored in the narrowest integral type holding all such values
+     *
+     * Bounded types sharing a Tag and Traits form a family. Addition, subtraction and multiplication of two members of
+     * a family return the member whose bounds are those of the result, so they never overflow nor throw: adding two
+     * bounded<0, 100, ...> returns a bounded<0, 200, ...>. Comparisons also work across a family. Other arithmetic
+     * operations return the same type as their operands, and throw std::out_of_range when their result is out of
+     * bounds. Converting between members of a family is done explicitly, from the value: percent(sum.value()).
+     *
+     * Traits which are not specialized for bounded types, such as addable_with<U>, also build their result through
+     * the validating constructor, but are noexcept: an out of bounds result terminates the program.
+     */
+    template <std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+    using bounded = type<details::bounded_value_t<Min, Max>, Tag, bounds<Min, Max>, Traits...>;
+
+    namespace details
+    {
+        /** Builds a T from the result of an operation, throws if it overflowed or is out of the bounds of T */
+        template <typename T>
+        constexpr T make_bounded(bool overflowed, std::intmax_t v)
+        {
+            if (overflowed)
+                throw std::out_of_range("st::bounded: value out of bounds");
+            return T(v);
+        }
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        using bounded_type = type<V, Tag, st::bounds<Min, Max>, Traits...>;
+    }
+
+    namespace traits
+    {
+        /*
+         * Specializations of the arithmetic traits for bounded types. Each of them gets the family of its bounded type
+         * T as a template alias, family<OtherMin, OtherMax>, so that operations accept any member of the family.
+         */
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct addable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr auto operator+(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                constexpr auto result = details::add_bounds(Min, Max, OtherMin, OtherMax);
+
+                return family<result.min, result.max>(
+                    static_cast<std::intmax_t>(lhs.value()) + static_cast<std::intmax_t>(rhs.value()));
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct subtractable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr auto operator-(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                constexpr auto result = details::sub_bounds(Min, Max, OtherMin, OtherMax);
+
+                return family<result.min, result.max>(
+                    static_cast<std::intmax_t>(lhs.value()) - static_cast<std::intmax_t>(rhs.value()));
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct multiplicable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr auto operator*(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                constexpr auto result = details::mul_bounds(Min, Max, OtherMin, OtherMax);
+
+                return family<result.min, result.max>(
+                    static_cast<std::intmax_t>(lhs.value()) * static_cast<std::intmax_t>(rhs.value()));
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct dividable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            friend constexpr T operator/(const T &lhs, const T &rhs)
+            {
+                std::intmax_t r{};
+                const bool overflowed = details::div_overflow(lhs.value(), rhs.value(), r);
+
+                return details::make_bounded<T>(overflowed, r);
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct modulable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            friend constexpr T operator%(const T &lhs, const T &rhs)
+            {
+                std::intmax_t r{};
+                const bool overflowed = details::mod_overflow(lhs.value(), rhs.value(), r);
+
+                return details::make_bounded<T>(overflowed, r);
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct add_assignable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr T &operator+=(T &lhs, const family<OtherMin, OtherMax> &rhs)
+            {
+                std::intmax_t r{};
+                const bool overflowed = details::add_overflow(lhs.value(), rhs.value(), r);
+
+                lhs = details::make_bounded<T>(overflowed, r);
+                return lhs;
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct subtract_assignable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr T &operator-=(T &lhs, const family<OtherMin, OtherMax> &rhs)
+            {
+                std::intmax_t r{};
+                const bool overflowed = details::sub_overflow(lhs.value(), rhs.value(), r);
+
+                lhs = details::make_bounded<T>(overflowed, r);
+                return lhs;
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct multiply_assignable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr T &operator*=(T &lhs, const family<OtherMin, OtherMax> &rhs)
+            {
+                std::intmax_t r{};
+                const bool overflowed = details::mul_overflow(lhs.value(), rhs.value(), r);
+
+                lhs = details::make_bounded<T>(overflowed, r);
+                return lhs;
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct divide_assignable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            friend constexpr T &operator/=(T &lhs, const T &rhs)
+            {
+                lhs = lhs / rhs;
+                return lhs;
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct modulo_assignable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            friend constexpr T &operator%=(T &lhs, const T &rhs)
+            {
+                lhs = lhs % rhs;
+                return lhs;
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct incrementable<details::bounded_type<V, Min, Max, Tag, Traits...>>
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            friend constexpr T &operator++(T &t)
+            {
+                std::intmax_t r{};
+                const bool overflowed = details::add_overflow(t.value(), 1, r);
+
+                t = details::make_bounded<T>(overflowed, r);
+                return t;
+            }
+
+            friend constexpr const T operator++(T &t, int)
+            {
+                T ret(t);
+
+                ++t;
+                return ret;
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct decrementable<details::bounded_type<V, Min, Max, Tag, Traits...>>
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            friend constexpr T &operator--(T &t)
+            {
+                std::intmax_t r{};
+                const bool overflowed = details::sub_overflow(t.value(), 1, r);
+
+                t = details::make_bounded<T>(overflowed, r);
+                return t;
+            }
+
+            friend constexpr const T operator--(T &t, int)
+            {
+                T ret(t);
+
+                --t;
+                return ret;
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct equality_comparable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            /* Unlike the family templates below, these accept operands converting to T, such as packed_reference */
+            friend constexpr bool operator==(const T &lhs, const T &rhs) noexcept
+            {
+                return lhs.value() == rhs.value();
+            }
+
+            friend constexpr bool operator!=(const T &lhs, const T &rhs) noexcept
+            {
+                return lhs.value() != rhs.value();
+            }
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr bool operator==(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                return static_cast<std::intmax_t>(lhs.value()) == static_cast<std::intmax_t>(rhs.value());
+            }
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr bool operator!=(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                return static_cast<std::intmax_t>(lhs.value()) != static_cast<std::intmax_t>(rhs.value());
+            }
+        };
+
+        template <typename V, std::intmax_t Min, std::intmax_t Max, typename Tag, typename ...Traits>
+        struct orderable<
+            details::bounded_type<V, Min, Max, Tag, Traits...>,
+            details::bounded_type<V, Min, Max, Tag, Traits...>
+        >
+        {
+            using T = details::bounded_type<V, Min, Max, Tag, Traits...>;
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            using family = bounded<OtherMin, OtherMax, Tag, Traits...>;
+
+            /* Unlike the family templates below, these accept operands converting to T, such as packed_reference */
+            friend constexpr bool operator<(const T &lhs, const T &rhs) noexcept
+            {
+                return lhs.value() < rhs.value();
+            }
+
+            friend constexpr bool operator<=(const T &lhs, const T &rhs) noexcept
+            {
+                return lhs.value() <= rhs.value();
+            }
+
+            friend constexpr bool operator>(const T &lhs, const T &rhs) noexcept
+            {
+                return lhs.value() > rhs.value();
+            }
+
+            friend constexpr bool operator>=(const T &lhs, const T &rhs) noexcept
+            {
+                return lhs.value() >= rhs.value();
+            }
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr bool operator<(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                return static_cast<std::intmax_t>(lhs.value()) < static_cast<std::intmax_t>(rhs.value());
+            }
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr bool operator<=(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                return static_cast<std::intmax_t>(lhs.value()) <= static_cast<std::intmax_t>(rhs.value());
+            }
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr bool operator>(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                return static_cast<std::intmax_t>(lhs.value()) > static_cast<std::intmax_t>(rhs.value());
+            }
+
+            template <std::intmax_t OtherMin, std::intmax_t OtherMax>
+            friend constexpr bool operator>=(const T &lhs, const family<OtherMin, OtherMax> &rhs) noexcept
+            {
+                return static_cast<std::intmax_t>(lhs.value()) >= static_cast<std::intmax_t>(rhs.value());
+            }
+        };
+    }
+}
+
+#endif /* !STRONG_TYPE_BOUNDED_HPP */
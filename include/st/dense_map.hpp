@@ -0,0 +1,231 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_DENSE_MAP_HPP
+#define STRONG_TYPE_DENSE_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <st/typed_vector.hpp>
+
+namespace st
+{
+    /**
+     * Associative container keyed by a strong index type, implemented as a sparse set
+     *
+     * A sparse array maps each key to a position in two dense arrays, which hold the keys and the values. Lookups are
+     * two array accesses, values are stored contiguously and erasing swaps the last value into the erased slot, so
+     * erasure invalidates iterators and references to the last value.
+     *
+     * The memory used by the sparse array grows with the largest key inserted, so keys are expected to be small. Keys of
+     * signed types must not be negative: inserting a negative key throws, and looking one up finds nothing.
+     */
+    template <typename IndexT, typename ValueT>
+    class dense_map
+    {
+        static_assert(is_indexable_v<IndexT>, "dense_map requires an indexable strong type as its key type");
+
+        using position_type = std::common_type_t<std::uint32_t, std::make_unsigned_t<typename IndexT::value_type>>;
+
+        static constexpr const position_type npos = std::numeric_limits<position_type>::max();
+
+    public:
+        using key_type = IndexT;
+        using mapped_type = ValueT;
+        using size_type = std::size_t;
+        using iterator = typename std::vector<ValueT>::iterator;
+        using const_iterator = typename std::vector<ValueT>::const_iterator;
+
+        bool contains(const IndexT &key) const noexcept
+        {
+            return _position(key) != npos;
+        }
+
+        size_type count(const IndexT &key) const noexcept
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        iterator find(const IndexT &key) noexcept
+        {
+            const auto pos = _position(key);
+
+            return pos == npos ? _values.end() : _values.begin() + static_cast<std::ptrdiff_t>(pos);
+        }
+
+        const_iterator find(const IndexT &key) const noexcept
+        {
+            const auto pos = _position(key);
+
+            return pos == npos ? _values.end() : _values.begin() + static_cast<std::ptrdiff_t>(pos);
+        }
+
+        ValueT &at(const IndexT &key)
+        {
+            const auto pos = _position(key);
+
+            if (pos == npos)
+                throw std::out_of_range("st::dense_map::at: no such key");
+            return _values[pos];
+        }
+
+        const ValueT &at(const IndexT &key) const
+        {
+            const auto pos = _position(key);
+
+            if (pos == npos)
+                throw std::out_of_range("st::dense_map::at: no such key");
+            return _values[pos];
+        }
+
+        ValueT &operator[](const IndexT &key)
+        {
+            return *try_emplace(key).first;
+        }
+
+        /**
+         * Constructs a value for key if there is none yet, returns an iterator to the value and whether it was added
+         *
+         * Throws std::out_of_range if key is negative, and std::length_error if it is too large for the sparse array.
+         */
+        template <typename ...Args>
+        std::pair<iterator, bool> try_emplace(const IndexT &key, Args &&...args)
+        {
+            if constexpr (std::is_signed_v<typename IndexT::value_type>) {
+                if (key.value() < 0)
+                    throw std::out_of_range("st::dense_map::try_emplace: negative key");
+            }
+
+            const auto raw = details::to_position(key);
+
+            if (raw < _sparse.size() && _sparse[raw] != npos)
+                return {_values.begin() + static_cast<std::ptrdiff_t>(_sparse[raw]), false};
+            if (raw >= _sparse.size()) {
+                /* max_size() is below the largest size_t, so that raw + 1 cannot wrap around */
+                if (raw >= _sparse.max_size())
+                    throw std::length_error("st::dense_map::try_emplace: key too large");
+                _sparse.resize(raw + 1, npos);
+            }
+            /* The key goes first, as it can be popped back without throwing if constructing the value throws */
+            _keys.push_back(key);
+            try {
+                _values.emplace_back(std::forward<Args>(args)...);
+            } catch (...) {
+                _keys.pop_back();
+                throw;
+            }
+            _sparse[raw] = static_cast<position_type>(_values.size() - 1);
+            return {_values.end() - 1, true};
+        }
+
+        std::pair<iterator, bool> insert(const IndexT &key, const ValueT &value)
+        {
+            return try_emplace(key, value);
+        }
+
+        std::pair<iterator, bool> insert(const IndexT &key, ValueT &&value)
+        {
+            return try_emplace(key, std::move(value));
+        }
+
+        /** Removes the value associated to key by moving the last value in its place */
+        size_type erase(const IndexT &key)
+        {
+            const auto pos = _position(key);
+
+            if (pos == npos)
+                return 0;
+            if (pos != _values.size() - 1) {
+                _values[pos] = std::move(_values.back());
+                _keys[pos] = _keys.back();
+                _sparse[details::to_position(_keys[pos])] = pos;
+            }
+            _values.pop_back();
+            _keys.pop_back();
+            _sparse[details::to_position(key)] = npos;
+            return 1;
+        }
+
+        void clear() noexcept
+        {
+            for (const auto &key : _keys)
+                _sparse[details::to_position(key)] = npos;
+            _values.clear();
+            _keys.clear();
+        }
+
+        void reserve(size_type count)
+        {
+            _values.reserve(count);
+            _keys.reserve(count);
+        }
+
+        size_type size() const noexcept
+        {
+            return _values.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return _values.empty();
+        }
+
+        /** Iteration goes over the values, in no particular order */
+        iterator begin() noexcept
+        {
+            return _values.begin();
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return _values.begin();
+        }
+
+        iterator end() noexcept
+        {
+            return _values.end();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return _values.end();
+        }
+
+        /** Keys of the values, in iteration order */
+        const std::vector<IndexT> &keys() const noexcept
+        {
+            return _keys;
+        }
+
+        /** Key of the value pointed to by it */
+        const IndexT &key_of(const_iterator it) const noexcept
+        {
+            return _keys[static_cast<size_type>(it - _values.begin())];
+        }
+
+    private:
+        position_type _position(const IndexT &key) const noexcept
+        {
+            if constexpr (std::is_signed_v<typename IndexT::value_type>) {
+                if (key.value() < 0)
+                    return npos;
+            }
+
+            const auto raw = details::to_position(key);
+
+            return raw < _sparse.size() ? _sparse[raw] : npos;
+        }
+
+        std::vector<position_type> _sparse;
+        std::vector<IndexT> _keys;
+        std::vector<ValueT> _values;
+    };
+}
+
+#endif /* !STRONG_TYPE_DENSE_MAP_HPP */
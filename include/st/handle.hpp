@@ -0,0 +1,64 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_HANDLE_HPP
+#define STRONG_TYPE_HANDLE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <st/traits.hpp>
+
+namespace st
+{
+    /**
+     * Generational handle, packing a 32 bits index and a 32 bits generation into a single 64 bits value
+     *
+     * The generation allows detecting handles to slots which have been reused since the handle was handed out.
+     * Containers handing out handles (such as st::slot_map) never use the generation 0, so that a default-constructed
+     * handle never refers to anything.
+     */
+    template <typename Tag>
+    struct STRONG_TYPE_EMPTY_BASES handle :
+        public st::type_base<std::uint64_t>,
+        public st::traits::equality_comparable<handle<Tag>>,
+        public st::traits::hashable<handle<Tag>>
+    {
+        using tag_type = Tag;
+        using index_type = std::uint32_t;
+        using generation_type = std::uint32_t;
+
+        using st::type_base<std::uint64_t>::type_base;
+
+        constexpr handle() = default;
+
+        constexpr handle(index_type idx, generation_type gen) noexcept :
+            st::type_base<std::uint64_t>((std::uint64_t(gen) << 32) | idx)
+        {
+        }
+
+        constexpr index_type index() const noexcept
+        {
+            return static_cast<index_type>(value());
+        }
+
+        constexpr generation_type generation() const noexcept
+        {
+            return static_cast<generation_type>(value() >> 32);
+        }
+    };
+}
+
+namespace std
+{
+    template <typename Tag>
+    struct hash<st::handle<Tag>>
+    {
+        auto operator()(const st::handle<Tag> &h) const
+        {
+            return st::details::hash_policy_t<st::handle<Tag>>()(h.value());
+        }
+    };
+}
+
+#endif /* !STRONG_TYPE_HANDLE_HPP */
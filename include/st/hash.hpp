@@ -0,0 +1,164 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_HASH_HPP
+#define STRONG_TYPE_HASH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <st/traits.hpp>
+
+namespace st
+{
+    namespace details
+    {
+        template <typename T>
+        using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+    }
+
+    /**
+     * Whether objects of type KeyT can be used to look up keys of the strong type T
+     *
+     * This holds for T itself, for its underlying type, and for any type whitelisted using the lookupable_with trait.
+     */
+    template <typename T, typename KeyT, bool = is_strong_type_v<T>>
+    struct is_lookup_key : std::false_type
+    {
+    };
+
+    template <typename T, typename KeyT>
+    struct is_lookup_key<T, KeyT, true> : std::bool_constant<
+        std::is_same_v<KeyT, T> ||
+        std::is_same_v<KeyT, typename T::value_type> ||
+        std::is_base_of_v<traits::lookupable_with<T, KeyT>, T>
+    >
+    {
+    };
+
+    template <typename T, typename KeyT>
+    inline constexpr const bool is_lookup_key_v = is_lookup_key<T, details::remove_cvref_t<KeyT>>::value;
+
+    namespace details
+    {
+        template <template <typename...> class TraitT, typename T, typename KeyT, bool = is_strong_type_v<T>>
+        inline constexpr bool is_lookup_key_with_v = false;
+
+        /** Whether KeyT is a lookup key of the strong type T, which has the trait TraitT */
+        template <template <typename...> class TraitT, typename T, typename KeyT>
+        inline constexpr bool is_lookup_key_with_v<TraitT, T, KeyT, true> =
+            is_lookup_key_v<T, KeyT> && std::is_base_of_v<TraitT<T>, T>;
+
+        /** Whether L and R can be compared as keys of the same strong type, which has the trait TraitT */
+        template <template <typename...> class TraitT, typename L, typename R>
+        inline constexpr bool are_lookup_keys_with_v =
+            is_lookup_key_with_v<TraitT, remove_cvref_t<L>, R> || is_lookup_key_with_v<TraitT, remove_cvref_t<R>, L>;
+
+        template <typename T, typename KeyT>
+        inline std::size_t hash_lookup_key(const KeyT &k)
+        {
+            if constexpr (std::is_same_v<KeyT, T>)
+                return std::hash<T>()(k);
+            else
+                return hash_policy_t<T>()(unwrap(k));
+        }
+    }
+
+    /**
+     * Transparent hash function for strong types
+     *
+     * st::hash<T> hashes a strong type T and any of its lookup keys using the hash policy of T. Whitelisted keys must
+     * hash like the underlying type does under that policy (as std::string_view does for std::string).
+     * st::hash<> only hashes strong types, each using its own hash policy: raw keys would need the policy of the
+     * strong type they stand for, so looking them up requires st::hash<T>.
+     */
+    template <typename T = void>
+    struct hash
+    {
+        using is_transparent = void;
+
+        template <typename KeyT, typename = std::enable_if_t<is_lookup_key_v<T, KeyT>>>
+        std::size_t operator()(const KeyT &k) const
+        {
+            return details::hash_lookup_key<T>(k);
+        }
+    };
+
+    template <>
+    struct hash<void>
+    {
+        using is_transparent = void;
+
+        template <typename KeyT, typename = std::enable_if_t<is_strong_type_v<KeyT>>>
+        std::size_t operator()(const KeyT &k) const
+        {
+            return std::hash<KeyT>()(k);
+        }
+    };
+
+    /**
+     * Transparent equality comparison for strong types
+     *
+     * st::equal_to<T> compares any two lookup keys of T. st::equal_to<> compares a strong type with any of its
+     * lookup keys, but never two unrelated strong types. Both require the strong type to be equality_comparable.
+     */
+    template <typename T = void>
+    struct equal_to
+    {
+        using is_transparent = void;
+
+        template <typename L, typename R, typename = std::enable_if_t<
+            details::is_lookup_key_with_v<traits::equality_comparable, T, L> && is_lookup_key_v<T, R>
+        >>
+        constexpr bool operator()(const L &lhs, const R &rhs) const
+        {
+            return unwrap(lhs) == unwrap(rhs);
+        }
+    };
+
+    template <>
+    struct equal_to<void>
+    {
+        using is_transparent = void;
+
+        template <typename L, typename R, typename = std::enable_if_t<
+            details::are_lookup_keys_with_v<traits::equality_comparable, L, R>
+        >>
+        constexpr bool operator()(const L &lhs, const R &rhs) const
+        {
+            return unwrap(lhs) == unwrap(rhs);
+        }
+    };
+
+    /** Transparent ordering of strong types, following the same rules as st::equal_to but requiring orderable */
+    template <typename T = void>
+    struct less
+    {
+        using is_transparent = void;
+
+        template <typename L, typename R, typename = std::enable_if_t<
+            details::is_lookup_key_with_v<traits::orderable, T, L> && is_lookup_key_v<T, R>
+        >>
+        constexpr bool operator()(const L &lhs, const R &rhs) const
+        {
+            return unwrap(lhs) < unwrap(rhs);
+        }
+    };
+
+    template <>
+    struct less<void>
+    {
+        using is_transparent = void;
+
+        template <typename L, typename R, typename = std::enable_if_t<
+            details::are_lookup_keys_with_v<traits::orderable, L, R>
+        >>
+        constexpr bool operator()(const L &lhs, const R &rhs) const
+        {
+            return unwrap(lhs) < unwrap(rhs);
+        }
+    };
+}
+
+#endif /* !STRONG_TYPE_HASH_HPP */
@@ -0,0 +1,212 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_HASH_POLICIES_HPP
+#define STRONG_TYPE_HASH_POLICIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/**
+ * Hash policies usable with the hashable_with trait
+ *
+ * A policy is a stateless function object mapping a value of the underlying type of a strong type to a std::size_t.
+ */
+namespace st::hash_policies
+{
+    namespace details
+    {
+        template <typename T, typename = void>
+        struct is_contiguous_bytes : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_contiguous_bytes<T, std::void_t<
+            decltype(std::data(std::declval<const T &>())),
+            decltype(std::size(std::declval<const T &>()))
+        >> : std::bool_constant<
+            std::is_trivially_copyable_v<std::remove_pointer_t<decltype(std::data(std::declval<const T &>()))>>
+        >
+        {
+        };
+
+        /** 64x64 -> 128 bits multiplication, folded back to 64 bits */
+        inline std::uint64_t mum(std::uint64_t a, std::uint64_t b) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            const auto r = static_cast<unsigned __int128>(a) * b;
+
+            return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            std::uint64_t hi;
+            const std::uint64_t lo = _umul128(a, b, &hi);
+
+            return lo ^ hi;
+#else
+            const std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a),
+                lb = static_cast<std::uint32_t>(b);
+            const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            const std::uint64_t t = rl + (rm0 << 32);
+            const std::uint64_t lo = t + (rm1 << 32);
+            const std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+
+            return lo ^ hi;
+#endif
+        }
+
+        inline std::uint64_t read64(const unsigned char *p) noexcept
+        {
+            std::uint64_t v;
+
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline std::uint64_t read32(const unsigned char *p) noexcept
+        {
+            std::uint32_t v;
+
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline constexpr std::uint64_t wyp0 = 0xa0761d6478bd642full;
+        inline constexpr std::uint64_t wyp1 = 0xe7037ed1a0b428dbull;
+        inline constexpr std::uint64_t wyp2 = 0x8ebc6af09c88c6e3ull;
+        inline constexpr std::uint64_t wyp3 = 0x589965cc75374cc3ull;
+
+        /** Hashes a byte buffer following the structure of wyhash */
+        inline std::uint64_t wyhash_bytes(const void *data, std::size_t len, std::uint64_t seed = 0) noexcept
+        {
+            const auto *p = static_cast<const unsigned char *>(data);
+            std::uint64_t a;
+            std::uint64_t b;
+
+            seed ^= wyp0;
+            if (len <= 16) {
+                if (len >= 4) {
+                    const std::size_t shift = (len >> 3) << 2;
+
+                    a = (read32(p) << 32) | read32(p + shift);
+                    b = (read32(p + len - 4) << 32) | read32(p + len - 4 - shift);
+                } else if (len > 0) {
+                    a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[len >> 1]) << 8) | p[len - 1];
+                    b = 0;
+                } else {
+                    a = 0;
+                    b = 0;
+                }
+            } else {
+                std::size_t i = len;
+
+                if (i > 48) {
+                    std::uint64_t see1 = seed;
+                    std::uint64_t see2 = seed;
+
+                    do {
+                        seed = mum(read64(p) ^ wyp1, read64(p + 8) ^ seed);
+                        see1 = mum(read64(p + 16) ^ wyp2, read64(p + 24) ^ see1);
+                        see2 = mum(read64(p + 32) ^ wyp3, read64(p + 40) ^ see2);
+                        p += 48;
+                        i -= 48;
+                    } while (i > 48);
+                    seed ^= see1 ^ see2;
+                }
+                while (i > 16) {
+                    seed = mum(read64(p) ^ wyp1, read64(p + 8) ^ seed);
+                    i -= 16;
+                    p += 16;
+                }
+                a = read64(p + i - 16);
+                b = read64(p + i - 8);
+            }
+            return mum(wyp1 ^ len, mum(a ^ wyp1, b ^ seed));
+        }
+
+        template <typename T>
+        inline constexpr std::uint64_t to_u64(const T &v) noexcept
+        {
+            if constexpr (std::is_enum_v<T>)
+                return static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(v));
+            else if constexpr (std::is_pointer_v<T>)
+                return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(v));
+            else
+                return static_cast<std::uint64_t>(v);
+        }
+
+        template <typename T>
+        inline constexpr bool is_word_v = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+    }
+
+    /** Forwards to std::hash, this is the policy used by the hashable trait */
+    struct standard
+    {
+        template <typename T>
+        std::size_t operator()(const T &v) const noexcept(noexcept(std::hash<T>()(v)))
+        {
+            return std::hash<T>()(v);
+        }
+    };
+
+    /**
+     * Multiplicative (Fibonacci) hashing for integral identifiers
+     *
+     * Consecutive or evenly spaced identifiers are spread over the whole output range, instead of mapping to
+     * consecutive buckets as they do with the identity hash used by most standard libraries.
+     */
+    struct fibonacci
+    {
+        template <typename T, typename = std::enable_if_t<details::is_word_v<T>>>
+        constexpr std::size_t operator()(const T &v) const noexcept
+        {
+            const std::uint64_t h = details::to_u64(v) * 0x9e3779b97f4a7c15ull;
+
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+    };
+
+    /**
+     * wyhash-style hashing, suited for byte strings
+     *
+     * Contiguous ranges of trivially copyable objects (such as std::string, std::string_view or std::vector<char>)
+     * are hashed by content, so that any two of them holding the same bytes hash the same. Integral values are mixed
+     * with a single wide multiplication.
+     */
+    struct wyhash
+    {
+        template <typename T>
+        std::size_t operator()(const T &v) const noexcept
+        {
+            if constexpr (details::is_word_v<T>) {
+                return static_cast<std::size_t>(details::mum(details::to_u64(v) ^ details::wyp0, details::wyp1));
+            } else {
+                static_assert(details::is_contiguous_bytes<T>::value,
+                              "wyhash can only hash integral values and contiguous ranges of trivial objects");
+                return static_cast<std::size_t>(
+                    details::wyhash_bytes(std::data(v), std::size(v) * sizeof(*std::data(v))));
+            }
+        }
+    };
+
+    /** Uses the value itself as its hash, for values which already are hashes */
+    struct identity
+    {
+        template <typename T, typename = std::enable_if_t<details::is_word_v<T>>>
+        constexpr std::size_t operator()(const T &v) const noexcept
+        {
+            return static_cast<std::size_t>(details::to_u64(v));
+        }
+    };
+}
+
+#endif /* !STRONG_TYPE_HASH_POLICIES_HPP */
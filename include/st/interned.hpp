@@ -0,0 +1,271 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_INTERNED_HPP
+#define STRONG_TYPE_INTERNED_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <st/type.hpp>
+
+namespace st
+{
+    namespace details
+    {
+        /** Header of an interned string, immediately followed by its null-terminated characters */
+        struct intern_entry
+        {
+            std::size_t hash;
+            std::size_t size;
+
+            const char *data() const noexcept
+            {
+                return reinterpret_cast<const char *>(this + 1);
+            }
+        };
+
+        struct empty_intern_entry
+        {
+            intern_entry entry;
+            char text[alignof(intern_entry)];
+        };
+
+        inline const empty_intern_entry empty_entry{{std::hash<std::string_view>()(std::string_view()), 0}, {}};
+    }
+
+    /**
+     * Thread-safe pool of interned strings
+     *
+     * Each distinct string is stored once, along with its hash, in chunks of memory which are only released when the
+     * pool is destroyed. Strings interned in the global pool therefore live until the end of the program.
+     */
+    class intern_pool
+    {
+    public:
+        intern_pool() = default;
+
+        intern_pool(const intern_pool &) = delete;
+
+        intern_pool &operator=(const intern_pool &) = delete;
+
+        static intern_pool &global()
+        {
+            static intern_pool pool;
+
+            return pool;
+        }
+
+        /** Returns the unique entry holding the characters of s */
+        const details::intern_entry *intern(std::string_view s)
+        {
+            if (s.empty())
+                return &details::empty_entry.entry;
+
+            {
+                std::shared_lock<std::shared_mutex> lock(_mutex);
+                auto it = _entries.find(s);
+
+                if (it != _entries.end())
+                    return it->second;
+            }
+
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            auto it = _entries.find(s);
+
+            if (it != _entries.end())
+                return it->second;
+
+            auto *entry = new (_allocate(sizeof(details::intern_entry) + s.size() + 1))
+                details::intern_entry{std::hash<std::string_view>()(s), s.size()};
+            auto *text = reinterpret_cast<char *>(entry + 1);
+
+            std::memcpy(text, s.data(), s.size());
+            text[s.size()] = '\0';
+            _entries.emplace(std::string_view(text, s.size()), entry);
+            return entry;
+        }
+
+        /** Number of distinct non-empty strings interned so far */
+        std::size_t size() const
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+
+            return _entries.size();
+        }
+
+    private:
+        static constexpr const std::size_t chunk_size = 64 * 1024;
+
+        void *_allocate(std::size_t size)
+        {
+            size = (size + alignof(details::intern_entry) - 1) & ~(alignof(details::intern_entry) - 1);
+            if (size > chunk_size) {
+                _chunks.emplace_back(new details::intern_entry[size / sizeof(details::intern_entry) + 1]);
+                return _chunks.back().get();
+            }
+            if (_chunks.empty() || _used + size > chunk_size) {
+                _chunks.emplace_back(new details::intern_entry[chunk_size / sizeof(details::intern_entry)]);
+                _current = reinterpret_cast<char *>(_chunks.back().get());
+                _used = 0;
+            }
+
+            void *ret = _current + _used;
+
+            _used += size;
+            return ret;
+        }
+
+        mutable std::shared_mutex _mutex;
+        std::unordered_map<std::string_view, const details::intern_entry *> _entries;
+        std::vector<std::unique_ptr<details::intern_entry[]>> _chunks;
+        char *_current = nullptr;
+        std::size_t _used = 0;
+    };
+
+    /**
+     * Handle to a string stored in an intern pool
+     *
+     * Copies are pointer copies, equality is a pointer comparison and the hash is computed once when interning.
+     * Ordering compares the characters lexicographically.
+     */
+    class interned_string
+    {
+    public:
+        constexpr interned_string() noexcept : _entry(&details::empty_entry.entry)
+        {
+        }
+
+        explicit interned_string(std::string_view s, intern_pool &pool = intern_pool::global()) :
+            _entry(pool.intern(s))
+        {
+        }
+
+        std::string_view view() const noexcept
+        {
+            return std::string_view(_entry->data(), _entry->size);
+        }
+
+        const char *c_str() const noexcept
+        {
+            return _entry->data();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _entry->size;
+        }
+
+        bool empty() const noexcept
+        {
+            return _entry->size == 0;
+        }
+
+        std::size_t hash() const noexcept
+        {
+            return _entry->hash;
+        }
+
+        friend bool operator==(const interned_string &lhs, const interned_string &rhs) noexcept
+        {
+            return lhs._entry == rhs._entry;
+        }
+
+        friend bool operator!=(const interned_string &lhs, const interned_string &rhs) noexcept
+        {
+            return lhs._entry != rhs._entry;
+        }
+
+        friend bool operator<(const interned_string &lhs, const interned_string &rhs) noexcept
+        {
+            return lhs._entry != rhs._entry && lhs.view() < rhs.view();
+        }
+
+        friend bool operator>(const interned_string &lhs, const interned_string &rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const interned_string &lhs, const interned_string &rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const interned_string &lhs, const interned_string &rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+        friend bool operator==(const interned_string &lhs, std::string_view rhs) noexcept
+        {
+            return lhs.view() == rhs;
+        }
+
+        friend bool operator==(std::string_view lhs, const interned_string &rhs) noexcept
+        {
+            return lhs == rhs.view();
+        }
+
+        friend bool operator!=(const interned_string &lhs, std::string_view rhs) noexcept
+        {
+            return lhs.view() != rhs;
+        }
+
+        friend bool operator!=(std::string_view lhs, const interned_string &rhs) noexcept
+        {
+            return lhs != rhs.view();
+        }
+
+        friend bool operator<(const interned_string &lhs, std::string_view rhs) noexcept
+        {
+            return lhs.view() < rhs;
+        }
+
+        friend bool operator<(std::string_view lhs, const interned_string &rhs) noexcept
+        {
+            return lhs < rhs.view();
+        }
+
+    private:
+        const details::intern_entry *_entry;
+    };
+
+    /**
+     * Strong type wrapping an interned string
+     *
+     * Traits apply to the interned string: equality_comparable compares pointers, hashable returns the stored hash and
+     * orderable compares characters. Adding lookupable_with<std::string_view> allows looking up interned keys from
+     * std::string_view through st::hash, st::equal_to and st::less, without interning the key first.
+     */
+    template <typename Tag, typename ...Traits>
+    using interned = type<interned_string, Tag, Traits...>;
+
+    /** Interns s into the global pool, and wraps it into the strong type S */
+    template <typename S>
+    S intern(std::string_view s)
+    {
+        return S(interned_string(s));
+    }
+}
+
+namespace std
+{
+    template <>
+    struct hash<st::interned_string>
+    {
+        std::size_t operator()(const st::interned_string &s) const noexcept
+        {
+            return s.hash();
+        }
+    };
+}
+
+#endif /* !STRONG_TYPE_INTERNED_HPP */
@@ -0,0 +1,280 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_LAZY_HPP
+#define STRONG_TYPE_LAZY_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <st/type.hpp>
+
+namespace st
+{
+    namespace details
+    {
+        struct lazy_negate
+        {
+            template <typename V>
+            constexpr auto operator()(const V &v) const noexcept
+            {
+                return -v;
+            }
+        };
+    }
+
+    /**
+     * Node of an element-wise expression over strong types T, built by the operators of lazy_arithmetic
+     *
+     * Operands are strong types, which are referred to when they are lvalues and moved into the node otherwise,
+     * other nodes, which are copied, and scalars. Converting a node to T evaluates the whole expression in a single
+     * loop into a single new payload. Nodes referring to lvalues must not outlive them, which makes
+     * auto e = a + b; a dangerous pattern, as with any expression template.
+     */
+    template <typename T, typename Op, typename ...Operands>
+    class lazy_expression
+    {
+    public:
+        using strong_type = T;
+
+        template <typename ...Args>
+        constexpr explicit lazy_expression(std::in_place_t, Args &&...args) : _operands(std::forward<Args>(args)...)
+        {
+        }
+
+        /** Size of the payloads of the expression, which must all have the same size */
+        std::size_t size() const noexcept
+        {
+            return std::apply([](const auto &...operands) { return size_of(operands...); }, _operands);
+        }
+
+        decltype(auto) operator[](std::size_t i) const
+        {
+            return std::apply([i](const auto &...operands) { return Op()(at(operands, i)...); }, _operands);
+        }
+
+        operator T() const
+        {
+            using payload_t = typename T::value_type;
+
+            const std::size_t n = size();
+            payload_t out = make_payload(n);
+
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = (*this)[i];
+            return T(std::move(out));
+        }
+
+    private:
+        template <typename, typename, typename ...>
+        friend class lazy_expression;
+
+        template <typename ...Others>
+        static std::size_t size_of(const T &operand, const Others &...) noexcept
+        {
+            return operand.value().size();
+        }
+
+        template <typename OtherOp, typename ...OtherOperands, typename ...Others>
+        static std::size_t size_of(const lazy_expression<T, OtherOp, OtherOperands...> &operand,
+                                   const Others &...) noexcept
+        {
+            return operand.size();
+        }
+
+        template <typename Scalar, typename ...Others, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+        static std::size_t size_of(const Scalar &, const Others &...others) noexcept
+        {
+            return size_of(others...);
+        }
+
+        static decltype(auto) at(const T &operand, std::size_t i)
+        {
+            return operand.value()[i];
+        }
+
+        template <typename OtherOp, typename ...OtherOperands>
+        static decltype(auto) at(const lazy_expression<T, OtherOp, OtherOperands...> &operand, std::size_t i)
+        {
+            return operand[i];
+        }
+
+        template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+        static Scalar at(const Scalar &operand, std::size_t) noexcept
+        {
+            return operand;
+        }
+
+        static typename T::value_type make_payload(std::size_t n)
+        {
+            using payload_t = typename T::value_type;
+
+            if constexpr (std::is_constructible_v<payload_t, std::size_t> && !std::is_aggregate_v<payload_t>) {
+                return payload_t(n);
+            } else {
+                /* Fixed-size payloads, such as std::array */
+                payload_t out{};
+
+                assert(out.size() == n);
+                return out;
+            }
+        }
+
+        std::tuple<Operands...> _operands;
+    };
+
+    namespace details
+    {
+        template <typename T, typename U>
+        struct is_lazy_node : std::false_type
+        {
+        };
+
+        template <typename T, typename Op, typename ...Operands>
+        struct is_lazy_node<T, lazy_expression<T, Op, Operands...>> : std::true_type
+        {
+        };
+
+        /** Whether Arg is a strong type T or an expression over T */
+        template <typename T, typename Arg>
+        inline constexpr bool is_lazy_operand_v =
+            std::is_same_v<std::decay_t<Arg>, T> || is_lazy_node<T, std::decay_t<Arg>>::value;
+
+        template <typename T, typename Arg>
+        inline constexpr bool is_lazy_argument_v = is_lazy_operand_v<T, Arg> || std::is_arithmetic_v<std::decay_t<Arg>>;
+
+        /** Lvalue strong types are referred to, everything else is held by value */
+        template <typename T, typename Arg>
+        using lazy_storage_t = std::conditional_t<
+            std::is_same_v<std::decay_t<Arg>, T> && std::is_lvalue_reference_v<Arg>,
+            const T &,
+            std::decay_t<Arg>
+        >;
+
+        template <typename T, typename Op, typename ...Args>
+        using lazy_node_t = lazy_expression<T, Op, lazy_storage_t<T, Args>...>;
+
+        /**
+         * Node applying Op to Args, if they are operands of T or scalars, and at least one is an operand
+         *
+         * Operators return this type rather than auto, so that the signatures of the friends defined by each
+         * lazy_arithmetic<T> depend on T.
+         */
+        template <typename T, typename Op, typename ...Args>
+        using lazy_result_t = std::enable_if_t<
+            (is_lazy_argument_v<T, Args> && ...) && (is_lazy_operand_v<T, Args> || ...),
+            lazy_node_t<T, Op, Args...>
+        >;
+
+        template <typename T, typename Op, typename ...Args>
+        constexpr lazy_node_t<T, Op, Args...> make_lazy(Args &&...args)
+        {
+            return lazy_node_t<T, Op, Args...>(std::in_place, std::forward<Args>(args)...);
+        }
+
+        template <typename T, typename Op, typename Arg>
+        void lazy_assign(T &lhs, const Arg &rhs)
+        {
+            auto &payload = lhs.value();
+            const lazy_expression<T, Op, const T &, const Arg &> expr(std::in_place, lhs, rhs);
+
+            assert(expr.size() == payload.size());
+            for (std::size_t i = 0; i < payload.size(); ++i)
+                payload[i] = expr[i];
+        }
+    }
+
+    namespace traits
+    {
+        template <typename T>
+        struct lazy_arithmetic;
+
+        template <typename V, typename Tag, typename ...Traits>
+        struct lazy_arithmetic<type<V, Tag, Traits...>>
+        {
+            using T = type<V, Tag, Traits...>;
+            using element_type = std::decay_t<decltype(std::declval<const V &>()[0])>;
+
+            static_assert(std::is_arithmetic_v<element_type>, "lazy arithmetic requires arithmetic elements");
+
+            template <typename L, typename R>
+            friend constexpr details::lazy_result_t<T, std::plus<>, L, R> operator+(L &&lhs, R &&rhs)
+            {
+                return details::make_lazy<T, std::plus<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+            }
+
+            template <typename L, typename R>
+            friend constexpr details::lazy_result_t<T, std::minus<>, L, R> operator-(L &&lhs, R &&rhs)
+            {
+                return details::make_lazy<T, std::minus<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+            }
+
+            template <typename L, typename R>
+            friend constexpr details::lazy_result_t<T, std::multiplies<>, L, R> operator*(L &&lhs, R &&rhs)
+            {
+                return details::make_lazy<T, std::multiplies<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+            }
+
+            template <typename L, typename R>
+            friend constexpr details::lazy_result_t<T, std::divides<>, L, R> operator/(L &&lhs, R &&rhs)
+            {
+                return details::make_lazy<T, std::divides<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+            }
+
+            template <typename L>
+            friend constexpr details::lazy_result_t<T, details::lazy_negate, L> operator-(L &&operand)
+            {
+                return details::make_lazy<T, details::lazy_negate>(std::forward<L>(operand));
+            }
+
+            template <typename R, typename = std::enable_if_t<details::is_lazy_argument_v<T, R>>>
+            friend T &operator+=(T &lhs, const R &rhs)
+            {
+                details::lazy_assign<T, std::plus<>>(lhs, rhs);
+                return lhs;
+            }
+
+            template <typename R, typename = std::enable_if_t<details::is_lazy_argument_v<T, R>>>
+            friend T &operator-=(T &lhs, const R &rhs)
+            {
+                details::lazy_assign<T, std::minus<>>(lhs, rhs);
+                return lhs;
+            }
+
+            template <typename R, typename = std::enable_if_t<details::is_lazy_argument_v<T, R>>>
+            friend T &operator*=(T &lhs, const R &rhs)
+            {
+                details::lazy_assign<T, std::multiplies<>>(lhs, rhs);
+                return lhs;
+            }
+
+            template <typename R, typename = std::enable_if_t<details::is_lazy_argument_v<T, R>>>
+            friend T &operator/=(T &lhs, const R &rhs)
+            {
+                details::lazy_assign<T, std::divides<>>(lhs, rhs);
+                return lhs;
+            }
+        };
+    }
+
+    /**
+     * Trait making the element-wise arithmetic operators of a strong type wrapping a sequence return expressions
+     *
+     * The wrapped type must provide size() and operator[] over arithmetic elements, and be constructible from a size
+     * unless it has a fixed size. +, -, * and / between strong types, expressions and scalars, as well as unary -,
+     * apply element-wise and build a lazy_expression, which is evaluated in a single fused loop when converted to the
+     * strong type: spectrum s = a + b * k + c; allocates a single payload. Compound assignments are evaluated in
+     * place and do not allocate. This trait replaces the arithmetic traits, and must not be combined with them.
+     */
+    struct lazy_arithmetic
+    {
+        template <typename T>
+        using type = traits::lazy_arithmetic<T>;
+    };
+}
+
+#endif /* !STRONG_TYPE_LAZY_HPP */
@@ -0,0 +1,360 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_OPTIONAL_HPP
+#define STRONG_TYPE_OPTIONAL_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <st/traits.hpp>
+#include <st/is_strong_type.hpp>
+#include <st/unwrap.hpp>
+
+namespace st
+{
+    namespace traits
+    {
+        template <typename T, auto Sentinel>
+        struct has_sentinel
+        {
+        };
+    }
+
+    /**
+     * Trait declaring that the underlying value Sentinel never stands for a valid value of the strong type
+     *
+     * Sentinel is converted to the underlying type, so that st::has_sentinel<-1> declares the largest value of an
+     * unsigned underlying type. st::optional uses it as its disengaged state.
+     */
+    template <auto Sentinel>
+    struct has_sentinel
+    {
+        template <typename T>
+        using type = traits::has_sentinel<T, Sentinel>;
+    };
+
+    namespace details
+    {
+        template <typename T, auto Sentinel>
+        std::integral_constant<decltype(Sentinel), Sentinel> sentinel_of(const traits::has_sentinel<T, Sentinel> &);
+
+        template <typename S, typename = void>
+        inline constexpr bool has_sentinel_v = false;
+
+        template <typename S>
+        using sentinel_t = decltype(sentinel_of<S>(std::declval<const S &>()));
+
+        template <typename S>
+        inline constexpr bool has_sentinel_v<S, std::void_t<sentinel_t<S>>> = true;
+
+        /** The sentinel of the strong type S, as an underlying value */
+        template <typename S>
+        constexpr typename S::value_type sentinel_value() noexcept
+        {
+            return static_cast<typename S::value_type>(sentinel_t<S>::value);
+        }
+    }
+
+    /**
+     * Optional strong type S, which stands for no value with the sentinel of S instead of a flag
+     *
+     * S must carry the has_sentinel trait, and sizeof(st::optional<S>) == sizeof(S). The interface is the one of
+     * std::optional, every operation being constexpr. Storing an S holding the sentinel is a precondition violation,
+     * since the optional would then hold no value. unwrap() returns the underlying value, which is the sentinel when
+     * the optional holds no value, so that optionals can be handed to code using the sentinel convention.
+     *
+     * == and != require S to be equality_comparable, and <, <=, > and >= require it to be orderable. As with
+     * std::optional, an empty optional is equal to std::nullopt and less than any value.
+     */
+    template <typename S>
+    class optional
+    {
+        static_assert(is_strong_type_v<S>, "st::optional can only hold strong types");
+        static_assert(details::has_sentinel_v<S>, "st::optional requires the has_sentinel trait");
+
+    public:
+        using value_type = S;
+
+        constexpr optional() noexcept : _value(details::sentinel_value<S>())
+        {
+        }
+
+        constexpr optional(std::nullopt_t) noexcept : optional()
+        {
+        }
+
+        constexpr optional(const S &value) noexcept(std::is_nothrow_copy_constructible_v<S>) : _value(value)
+        {
+            assert(has_value());
+        }
+
+        template <typename ...Args, typename = std::enable_if_t<std::is_constructible_v<S, Args &&...>>>
+        constexpr explicit optional(std::in_place_t, Args &&...args) : _value(std::forward<Args>(args)...)
+        {
+            assert(has_value());
+        }
+
+        constexpr optional &operator=(std::nullopt_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        constexpr optional &operator=(const S &value) noexcept(std::is_nothrow_copy_assignable_v<S>)
+        {
+            _value = value;
+            assert(has_value());
+            return *this;
+        }
+
+        template <typename ...Args>
+        constexpr S &emplace(Args &&...args)
+        {
+            _value = S(std::forward<Args>(args)...);
+            assert(has_value());
+            return _value;
+        }
+
+        constexpr void reset() noexcept
+        {
+            _value = S(details::sentinel_value<S>());
+        }
+
+        constexpr void swap(optional &other) noexcept
+        {
+            const S tmp = _value;
+
+            _value = other._value;
+            other._value = tmp;
+        }
+
+        constexpr bool has_value() const noexcept
+        {
+            return !(_value.value() == details::sentinel_value<S>());
+        }
+
+        constexpr explicit operator bool() const noexcept
+        {
+            return has_value();
+        }
+
+        constexpr S &value() &
+        {
+            _check();
+            return _value;
+        }
+
+        constexpr const S &value() const &
+        {
+            _check();
+            return _value;
+        }
+
+        constexpr S &&value() &&
+        {
+            _check();
+            return std::move(_value);
+        }
+
+        constexpr const S &&value() const &&
+        {
+            _check();
+            return std::move(_value);
+        }
+
+        template <typename U>
+        constexpr S value_or(U &&default_value) const
+        {
+            return has_value() ? _value : static_cast<S>(std::forward<U>(default_value));
+        }
+
+        constexpr S &operator*() & noexcept
+        {
+            assert(has_value());
+            return _value;
+        }
+
+        constexpr const S &operator*() const & noexcept
+        {
+            assert(has_value());
+            return _value;
+        }
+
+        constexpr S &&operator*() && noexcept
+        {
+            assert(has_value());
+            return std::move(_value);
+        }
+
+        constexpr const S &&operator*() const && noexcept
+        {
+            assert(has_value());
+            return std::move(_value);
+        }
+
+        constexpr S *operator->() noexcept
+        {
+            assert(has_value());
+            return &_value;
+        }
+
+        constexpr const S *operator->() const noexcept
+        {
+            assert(has_value());
+            return &_value;
+        }
+
+        /** The underlying value, which is the sentinel when the optional holds no value */
+        constexpr const typename S::value_type &underlying() const noexcept
+        {
+            return _value.value();
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        friend constexpr bool operator==(const optional &lhs, const optional &rhs) noexcept
+        {
+            return lhs.has_value() == rhs.has_value() && (!lhs.has_value() || lhs._value == rhs._value);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        friend constexpr bool operator!=(const optional &lhs, const optional &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        friend constexpr bool operator==(const optional &lhs, const S &rhs) noexcept
+        {
+            return lhs.has_value() && lhs._value == rhs;
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        friend constexpr bool operator==(const S &lhs, const optional &rhs) noexcept
+        {
+            return rhs == lhs;
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        friend constexpr bool operator!=(const optional &lhs, const S &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::equality_comparable<_S>, _S>>>
+        friend constexpr bool operator!=(const S &lhs, const optional &rhs) noexcept
+        {
+            return !(rhs == lhs);
+        }
+
+        friend constexpr bool operator==(const optional &lhs, std::nullopt_t) noexcept
+        {
+            return !lhs.has_value();
+        }
+
+        friend constexpr bool operator==(std::nullopt_t, const optional &rhs) noexcept
+        {
+            return !rhs.has_value();
+        }
+
+        friend constexpr bool operator!=(const optional &lhs, std::nullopt_t) noexcept
+        {
+            return lhs.has_value();
+        }
+
+        friend constexpr bool operator!=(std::nullopt_t, const optional &rhs) noexcept
+        {
+            return rhs.has_value();
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::orderable<_S>, _S>>>
+        friend constexpr bool operator<(const optional &lhs, const optional &rhs) noexcept
+        {
+            return rhs.has_value() && (!lhs.has_value() || lhs._value < rhs._value);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::orderable<_S>, _S>>>
+        friend constexpr bool operator<=(const optional &lhs, const optional &rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::orderable<_S>, _S>>>
+        friend constexpr bool operator>(const optional &lhs, const optional &rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::orderable<_S>, _S>>>
+        friend constexpr bool operator>=(const optional &lhs, const optional &rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+    private:
+        constexpr void _check() const
+        {
+            if (!has_value())
+                throw std::bad_optional_access();
+        }
+
+        S _value;
+    };
+
+    template <typename S>
+    optional(S) -> optional<S>;
+
+    template <typename S>
+    constexpr optional<std::decay_t<S>> make_optional(S &&value)
+    {
+        return optional<std::decay_t<S>>(std::forward<S>(value));
+    }
+
+    template <typename S>
+    constexpr void swap(optional<S> &lhs, optional<S> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /**
+     * The underlying value of an optional, which is the sentinel when it holds no value
+     *
+     * These overloads are more specialized than the generic unwrap(), and are found by argument-dependent lookup from
+     * the operators of the traits.
+     */
+    template <typename S>
+    constexpr const typename S::value_type &unwrap(const optional<S> &o) noexcept
+    {
+        return o.underlying();
+    }
+
+    template <typename S>
+    constexpr const typename S::value_type &unwrap(optional<S> &o) noexcept
+    {
+        return o.underlying();
+    }
+
+    template <typename S>
+    constexpr typename S::value_type unwrap(optional<S> &&o) noexcept
+    {
+        return o.underlying();
+    }
+}
+
+namespace std
+{
+    template <typename S>
+    struct hash<st::optional<S>>
+    {
+        auto operator()(const st::optional<S> &o) const
+        {
+            return o.has_value() ? std::hash<S>()(*o) : std::size_t(0);
+        }
+    };
+}
+
+#endif /* !STRONG_TYPE_OPTIONAL_HPP */
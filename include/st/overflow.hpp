@@ -0,0 +1,574 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_OVERFLOW_HPP
+#define STRONG_TYPE_OVERFLOW_HPP
+
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <st/traits.hpp>
+
+#if !defined(STRONG_TYPE_NO_OVERFLOW_BUILTINS) && (defined(__GNUC__) || defined(__clang__))
+#define STRONG_TYPE_OVERFLOW_BUILTINS
+#endif
+
+namespace st
+{
+    namespace details
+    {
+        template <typename T>
+        constexpr bool is_negative(T t) noexcept
+        {
+            if constexpr (std::is_signed_v<T>)
+                return t < 0;
+            else
+                return false;
+        }
+
+        /** Converts t to R, returns whether its value changed */
+        template <typename R, typename T>
+        constexpr bool convert_overflow(T t, R &r) noexcept
+        {
+            r = static_cast<R>(t);
+            return static_cast<T>(r) != t || is_negative(r) != is_negative(t);
+        }
+
+        /** Unsigned type at least as wide as unsigned int, so that its arithmetic is never promoted to int */
+        template <typename T>
+        using wrapping_arithmetic_t = std::make_unsigned_t<std::common_type_t<T, unsigned int>>;
+
+        /*
+         * The portable fallbacks convert both operands to R first, so operands which do not fit in R are reported as
+         * overflows even when the result would fit. They compute in unsigned arithmetic, and detect overflows from
+         * the sign bits of the operands and of the wrapped result.
+         */
+
+        template <typename R, typename A, typename B>
+        constexpr bool add_overflow(A a, B b, R &r) noexcept
+        {
+#if defined(STRONG_TYPE_OVERFLOW_BUILTINS)
+            return __builtin_add_overflow(a, b, &r);
+#else
+            using U = wrapping_arithmetic_t<R>;
+            R ra{};
+            R rb{};
+            const bool converted = convert_overflow(a, ra) | convert_overflow(b, rb);
+
+            r = static_cast<R>(static_cast<U>(static_cast<U>(ra) + static_cast<U>(rb)));
+            if constexpr (std::is_signed_v<R>)
+                return converted || ((ra ^ r) & (rb ^ r)) < 0;
+            else
+                return converted || r < ra;
+#endif
+        }
+
+        template <typename R, typename A, typename B>
+        constexpr bool sub_overflow(A a, B b, R &r) noexcept
+        {
+#if defined(STRONG_TYPE_OVERFLOW_BUILTINS)
+            return __builtin_sub_overflow(a, b, &r);
+#else
+            using U = wrapping_arithmetic_t<R>;
+            R ra{};
+            R rb{};
+            const bool converted = convert_overflow(a, ra) | convert_overflow(b, rb);
+
+            r = static_cast<R>(static_cast<U>(static_cast<U>(ra) - static_cast<U>(rb)));
+            if constexpr (std::is_signed_v<R>)
+                return converted || ((ra ^ rb) & (ra ^ r)) < 0;
+            else
+                return converted || ra < rb;
+#endif
+        }
+
+        template <typename R, typename A, typename B>
+        constexpr bool mul_overflow(A a, B b, R &r) noexcept
+        {
+#if defined(STRONG_TYPE_OVERFLOW_BUILTINS)
+            return __builtin_mul_overflow(a, b, &r);
+#else
+            using U = wrapping_arithmetic_t<R>;
+            R ra{};
+            R rb{};
+            const bool converted = convert_overflow(a, ra) | convert_overflow(b, rb);
+
+            r = static_cast<R>(static_cast<U>(static_cast<U>(ra) * static_cast<U>(rb)));
+            if constexpr (std::is_signed_v<R>) {
+                if (ra == -1 && rb == std::numeric_limits<R>::min())
+                    return true;
+            }
+            return converted || (ra != 0 && r / ra != rb);
+#endif
+        }
+
+        /**
+         * Division only overflows for the minimum of a signed type divided by -1
+         *
+         * Dividing by zero is reported as an overflow too, whose wrapped result is 0, so that it is handled by the
+         * overflow policy instead of being undefined behavior.
+         */
+        template <typename R, typename A, typename B>
+        constexpr bool div_overflow(A a, B b, R &r) noexcept
+        {
+            R ra{};
+            R rb{};
+            const bool converted = convert_overflow(a, ra) | convert_overflow(b, rb);
+
+            if (rb == 0) {
+                r = 0;
+                return true;
+            }
+            if constexpr (std::is_signed_v<R>) {
+                using U = wrapping_arithmetic_t<R>;
+
+                if (rb == -1) {
+                    r = static_cast<R>(static_cast<U>(U() - static_cast<U>(ra)));
+                    return converted || ra == std::numeric_limits<R>::min();
+                }
+            }
+            r = static_cast<R>(ra / rb);
+            return converted;
+        }
+
+        /** The remainder never overflows, but a zero divisor is reported as div_overflow() does */
+        template <typename R, typename A, typename B>
+        constexpr bool mod_overflow(A a, B b, R &r) noexcept
+        {
+            R ra{};
+            R rb{};
+            const bool converted = convert_overflow(a, ra) | convert_overflow(b, rb);
+
+            if (rb == 0) {
+                r = 0;
+                return true;
+            }
+            if constexpr (std::is_signed_v<R>) {
+                /* The remainder is always 0, but min % -1 is undefined behavior */
+                if (rb == -1) {
+                    r = 0;
+                    return converted;
+                }
+            }
+            r = static_cast<R>(ra % rb);
+            return converted;
+        }
+
+        template <typename T>
+        inline constexpr bool is_checkable_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+        /**
+         * Maximum of R if up is true, minimum otherwise
+         *
+         * Computed with bitwise operations rather than a conditional, which lets compilers keep the saturation out of
+         * the hot path behind a single overflow flag test.
+         */
+        template <typename R>
+        constexpr R saturate_up(bool up) noexcept
+        {
+            using U = wrapping_arithmetic_t<R>;
+            const auto mask = static_cast<U>(U() - static_cast<U>(up));
+
+            if constexpr (std::is_signed_v<R>)
+                return static_cast<R>(static_cast<U>(std::numeric_limits<R>::min()) ^ mask);
+            else
+                return static_cast<R>(mask);
+        }
+
+        /**
+         * Applies an arithmetic operation to a and b with the overflow policy PolicyT
+         *
+         * The operation computes the wrapped result and reports whether it overflowed. The policy then decides what
+         * to do with it, given the value the result would saturate to.
+         */
+        template <typename PolicyT, typename R, typename A, typename B>
+        constexpr R add_with(A a, B b) noexcept(PolicyT::is_noexcept)
+        {
+            static_assert(is_checkable_v<R>, "checked arithmetic requires an integral underlying type");
+
+            R r{};
+            const bool overflowed = add_overflow(a, b, r);
+
+            return PolicyT::resolve(overflowed, r, saturate_up<R>(!is_negative(b)));
+        }
+
+        template <typename PolicyT, typename R, typename A, typename B>
+        constexpr R sub_with(A a, B b) noexcept(PolicyT::is_noexcept)
+        {
+            static_assert(is_checkable_v<R>, "checked arithmetic requires an integral underlying type");
+
+            R r{};
+            const bool overflowed = sub_overflow(a, b, r);
+
+            return PolicyT::resolve(overflowed, r, saturate_up<R>(is_negative(b)));
+        }
+
+        template <typename PolicyT, typename R, typename A, typename B>
+        constexpr R mul_with(A a, B b) noexcept(PolicyT::is_noexcept)
+        {
+            static_assert(is_checkable_v<R>, "checked arithmetic requires an integral underlying type");
+
+            R r{};
+            const bool overflowed = mul_overflow(a, b, r);
+
+            return PolicyT::resolve(overflowed, r, saturate_up<R>(is_negative(a) == is_negative(b)));
+        }
+
+        template <typename PolicyT, typename R, typename A, typename B>
+        constexpr R div_with(A a, B b) noexcept(PolicyT::is_noexcept)
+        {
+            static_assert(is_checkable_v<R>, "checked arithmetic requires an integral underlying type");
+
+            R r{};
+            const bool overflowed = div_overflow(a, b, r);
+
+            return PolicyT::resolve(overflowed, r, saturate_up<R>(is_negative(a) == is_negative(b)));
+        }
+
+        template <typename PolicyT, typename R, typename A, typename B>
+        constexpr R mod_with(A a, B b) noexcept(PolicyT::is_noexcept)
+        {
+            static_assert(is_checkable_v<R>, "checked arithmetic requires an integral underlying type");
+
+            R r{};
+            const bool overflowed = mod_overflow(a, b, r);
+
+            return PolicyT::resolve(overflowed, r, r);
+        }
+
+        template <typename T>
+        using checked_value_t = std::decay_t<decltype(std::declval<const T &>().value())>;
+    }
+
+    /**
+     * Overflow policies of the checked arithmetic traits
+     *
+     * A policy decides what an operation whose result does not fit in the underlying type returns: the wrapped
+     * result (modulo 2^N), the closest representable value, an exception or a trap. Results which fit are returned
+     * unchanged by all policies.
+     */
+    namespace overflow
+    {
+        /** Wraps around, as unsigned arithmetic does, without undefined behavior for signed types */
+        struct wrapping
+        {
+            static constexpr const bool is_noexcept = true;
+
+            template <typename T>
+            static constexpr T resolve(bool, T wrapped, T) noexcept
+            {
+                return wrapped;
+            }
+        };
+
+        /** Clamps to the minimum or maximum of the underlying type */
+        struct saturating
+        {
+            static constexpr const bool is_noexcept = true;
+
+            template <typename T>
+            static constexpr T resolve(bool overflowed, T wrapped, T saturated) noexcept
+            {
+                return overflowed ? saturated : wrapped;
+            }
+        };
+
+        /** Throws std::overflow_error */
+        struct checked
+        {
+            static constexpr const bool is_noexcept = false;
+
+            template <typename T>
+            static constexpr T resolve(bool overflowed, T wrapped, T)
+            {
+                if (overflowed)
+                    throw std::overflow_error("st: arithmetic overflow");
+                return wrapped;
+            }
+        };
+
+        /** Terminates the program immediately, without unwinding */
+        struct trapping
+        {
+            static constexpr const bool is_noexcept = true;
+
+            template <typename T>
+            static constexpr T resolve(bool overflowed, T wrapped, T) noexcept
+            {
+                if (overflowed) {
+#if defined(__GNUC__) || defined(__clang__)
+                    __builtin_trap();
+#else
+                    std::abort();
+#endif
+                }
+                return wrapped;
+            }
+        };
+    }
+
+    namespace traits
+    {
+        template <typename T, typename PolicyT, typename OtherOperandT = T, typename ReturnT = T>
+        struct addable_checked
+        {
+            friend constexpr ReturnT operator+(const T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                return ReturnT(details::add_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs)));
+            }
+
+            template <typename _T = T, typename _Other = OtherOperandT,
+                typename = std::enable_if_t<!std::is_same_v<_T, _Other>>>
+            friend constexpr ReturnT operator+(const OtherOperandT &lhs, const T &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                return ReturnT(details::add_with<PolicyT, details::checked_value_t<T>>(unwrap(lhs), rhs.value()));
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T>
+        struct add_assignable_checked
+        {
+            friend constexpr T &operator+=(T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                lhs.value() = details::add_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs));
+                return lhs;
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T, typename ReturnT = T>
+        struct subtractable_checked
+        {
+            friend constexpr ReturnT operator-(const T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                return ReturnT(details::sub_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs)));
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T>
+        struct subtract_assignable_checked
+        {
+            friend constexpr T &operator-=(T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                lhs.value() = details::sub_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs));
+                return lhs;
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T, typename ReturnT = T>
+        struct multiplicable_checked
+        {
+            friend constexpr ReturnT operator*(const T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                return ReturnT(details::mul_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs)));
+            }
+
+            template <typename _T = T, typename _Other = OtherOperandT,
+                typename = std::enable_if_t<!std::is_same_v<_T, _Other>>>
+            friend constexpr ReturnT operator*(const OtherOperandT &lhs, const T &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                return ReturnT(details::mul_with<PolicyT, details::checked_value_t<T>>(unwrap(lhs), rhs.value()));
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T>
+        struct multiply_assignable_checked
+        {
+            friend constexpr T &operator*=(T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                lhs.value() = details::mul_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs));
+                return lhs;
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T, typename ReturnT = T>
+        struct dividable_checked
+        {
+            friend constexpr ReturnT operator/(const T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                return ReturnT(details::div_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs)));
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T>
+        struct divide_assignable_checked
+        {
+            friend constexpr T &operator/=(T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                lhs.value() = details::div_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs));
+                return lhs;
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T, typename ReturnT = T>
+        struct modulable_checked
+        {
+            friend constexpr ReturnT operator%(const T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                return ReturnT(details::mod_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs)));
+            }
+        };
+
+        template <typename T, typename PolicyT, typename OtherOperandT = T>
+        struct modulo_assignable_checked
+        {
+            friend constexpr T &operator%=(T &lhs, const OtherOperandT &rhs) noexcept(PolicyT::is_noexcept)
+            {
+                lhs.value() = details::mod_with<PolicyT, details::checked_value_t<T>>(lhs.value(), unwrap(rhs));
+                return lhs;
+            }
+        };
+
+        template <typename T, typename PolicyT>
+        struct incrementable_checked
+        {
+            friend constexpr T &operator++(T &t) noexcept(PolicyT::is_noexcept)
+            {
+                t.value() = details::add_with<PolicyT, details::checked_value_t<T>>(t.value(), 1);
+                return t;
+            }
+
+            friend constexpr const T operator++(T &t, int) noexcept(PolicyT::is_noexcept)
+            {
+                T ret(t);
+
+                t.value() = details::add_with<PolicyT, details::checked_value_t<T>>(t.value(), 1);
+                return ret;
+            }
+        };
+
+        template <typename T, typename PolicyT>
+        struct decrementable_checked
+        {
+            friend constexpr T &operator--(T &t) noexcept(PolicyT::is_noexcept)
+            {
+                t.value() = details::sub_with<PolicyT, details::checked_value_t<T>>(t.value(), 1);
+                return t;
+            }
+
+            friend constexpr const T operator--(T &t, int) noexcept(PolicyT::is_noexcept)
+            {
+                T ret(t);
+
+                t.value() = details::sub_with<PolicyT, details::checked_value_t<T>>(t.value(), 1);
+                return ret;
+            }
+        };
+    }
+
+    template <typename PolicyT = overflow::checked>
+    struct addable_checked
+    {
+        template <typename T>
+        using type = traits::addable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct add_assignable_checked
+    {
+        template <typename T>
+        using type = traits::add_assignable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct subtractable_checked
+    {
+        template <typename T>
+        using type = traits::subtractable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct subtract_assignable_checked
+    {
+        template <typename T>
+        using type = traits::subtract_assignable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct multiplicable_checked
+    {
+        template <typename T>
+        using type = traits::multiplicable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct multiply_assignable_checked
+    {
+        template <typename T>
+        using type = traits::multiply_assignable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct dividable_checked
+    {
+        template <typename T>
+        using type = traits::dividable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct divide_assignable_checked
+    {
+        template <typename T>
+        using type = traits::divide_assignable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct modulable_checked
+    {
+        template <typename T>
+        using type = traits::modulable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct modulo_assignable_checked
+    {
+        template <typename T>
+        using type = traits::modulo_assignable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct incrementable_checked
+    {
+        template <typename T>
+        using type = traits::incrementable_checked<T, PolicyT>;
+    };
+
+    template <typename PolicyT = overflow::checked>
+    struct decrementable_checked
+    {
+        template <typename T>
+        using type = traits::decrementable_checked<T, PolicyT>;
+    };
+
+    /** Same as arithmetic, with every operation handling overflows according to PolicyT */
+    template <typename PolicyT = overflow::checked>
+    struct arithmetic_checked : trait_bundle<
+        addable_checked<PolicyT>,
+        subtractable_checked<PolicyT>,
+        multiplicable_checked<PolicyT>,
+        dividable_checked<PolicyT>,
+        modulable_checked<PolicyT>,
+        add_assignable_checked<PolicyT>,
+        subtract_assignable_checked<PolicyT>,
+        multiply_assignable_checked<PolicyT>,
+        divide_assignable_checked<PolicyT>,
+        modulo_assignable_checked<PolicyT>,
+        incrementable_checked<PolicyT>,
+        decrementable_checked<PolicyT>,
+        equality_comparable,
+        orderable
+    >
+    {
+    };
+
+    using addable_saturating = addable_checked<overflow::saturating>;
+    using subtractable_saturating = subtractable_checked<overflow::saturating>;
+    using multiplicable_saturating = multiplicable_checked<overflow::saturating>;
+
+    using arithmetic_wrapping = arithmetic_checked<overflow::wrapping>;
+    using arithmetic_saturating = arithmetic_checked<overflow::saturating>;
+    using arithmetic_trapping = arithmetic_checked<overflow::trapping>;
+}
+
+#endif /* !STRONG_TYPE_OVERFLOW_HPP */
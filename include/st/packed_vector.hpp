@@ -0,0 +1,657 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_PACKED_VECTOR_HPP
+#define STRONG_TYPE_PACKED_VECTOR_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <st/unwrap.hpp>
+#include <st/span.hpp>
+
+#if defined(__AVX2__)
+#define STRONG_TYPE_PACKED_AVX2
+#include <immintrin.h>
+#endif
+
+namespace st
+{
+    namespace details
+    {
+        template <typename S, typename = void>
+        inline constexpr bool has_bounds_v = false;
+
+        template <typename S>
+        inline constexpr bool has_bounds_v<S, std::void_t<decltype(S::min_value), decltype(S::max_value)>> = true;
+
+        constexpr std::size_t bit_width(std::uintmax_t v) noexcept
+        {
+            std::size_t width = 0;
+
+            while (v != 0) {
+                ++width;
+                v >>= 1;
+            }
+            return width;
+        }
+
+        /** Value stored as 0 in a packed_vector: the lower bound of bounded types, 0 otherwise */
+        template <typename S>
+        constexpr std::intmax_t packed_offset() noexcept
+        {
+            if constexpr (has_bounds_v<S>) {
+                return S::min_value;
+            } else {
+                return 0;
+            }
+        }
+
+        /** Bits needed to hold every value of S: enough for Max - Min for bounded types, all bits otherwise */
+        template <typename S>
+        constexpr std::size_t packed_bits() noexcept
+        {
+            if constexpr (has_bounds_v<S>) {
+                const auto max = static_cast<std::uintmax_t>(S::max_value);
+                const auto range = max - static_cast<std::uintmax_t>(S::min_value);
+
+                return range == 0 ? 1 : bit_width(range);
+            } else {
+                return std::numeric_limits<typename S::value_type>::digits;
+            }
+        }
+
+        template <typename S>
+        inline constexpr std::size_t packed_bits_v = packed_bits<S>();
+
+        /**
+         * Encoding of strong types as Bits wide unsigned integers, the value at index i starting at bit i * Bits
+         *
+         * Each value is read and written with a single unaligned 64 bits access starting at its first byte, which
+         * requires Bits to be at most 57 and the storage to extend 8 bytes past the last value.
+         */
+        template <typename S, std::size_t Bits>
+        struct packed_codec
+        {
+            using value_type_t = typename S::value_type;
+
+            static constexpr std::uint64_t mask = (std::uint64_t(1) << Bits) - 1;
+            static constexpr std::uint64_t offset = static_cast<std::uint64_t>(packed_offset<S>());
+
+            static std::uint64_t load_word(const unsigned char *p) noexcept
+            {
+                std::uint64_t word;
+
+                std::memcpy(&word, p, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                word = __builtin_bswap64(word);
+#endif
+                return word;
+            }
+
+            static void store_word(unsigned char *p, std::uint64_t word) noexcept
+            {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                word = __builtin_bswap64(word);
+#endif
+                std::memcpy(p, &word, sizeof(word));
+            }
+
+            static std::uint64_t load(const unsigned char *bytes, std::size_t index) noexcept
+            {
+                const std::size_t pos = index * Bits;
+
+                return (load_word(bytes + pos / 8) >> (pos % 8)) & mask;
+            }
+
+            static void store(unsigned char *bytes, std::size_t index, std::uint64_t raw) noexcept
+            {
+                const std::size_t pos = index * Bits;
+                const std::uint64_t word = load_word(bytes + pos / 8) & ~(mask << (pos % 8));
+
+                store_word(bytes + pos / 8, word | (raw << (pos % 8)));
+            }
+
+            static value_type_t decode(std::uint64_t raw) noexcept
+            {
+                return static_cast<value_type_t>(raw + offset);
+            }
+
+            static std::uint64_t encode(const S &s)
+            {
+                const auto raw = static_cast<std::uint64_t>(s.value()) - offset;
+
+                if (raw > mask)
+                    throw std::out_of_range("st::packed_vector: value does not fit in the packed width");
+                return raw;
+            }
+        };
+    }
+
+    /**
+     * Proxy standing for an element of a packed_vector
+     *
+     * It converts to S, can be assigned an S, and unwrap() returns the underlying value. Comparison operators of S
+     * accept it through its conversion to S.
+     */
+    template <typename S, std::size_t Bits>
+    class packed_reference
+    {
+        using codec = details::packed_codec<S, Bits>;
+
+    public:
+        using value_type = typename S::value_type;
+
+        packed_reference(unsigned char *bytes, std::size_t index) noexcept : _bytes(bytes), _index(index)
+        {
+        }
+
+        packed_reference(const packed_reference &) noexcept = default;
+
+        packed_reference &operator=(const S &s)
+        {
+            codec::store(_bytes, _index, codec::encode(s));
+            return *this;
+        }
+
+        packed_reference &operator=(const packed_reference &other) noexcept
+        {
+            codec::store(_bytes, _index, codec::load(other._bytes, other._index));
+            return *this;
+        }
+
+        operator S() const
+        {
+            return S(value());
+        }
+
+        value_type value() const noexcept
+        {
+            return codec::decode(codec::load(_bytes, _index));
+        }
+
+        friend void swap(packed_reference lhs, packed_reference rhs) noexcept
+        {
+            const auto raw = codec::load(lhs._bytes, lhs._index);
+
+            lhs = rhs;
+            codec::store(rhs._bytes, rhs._index, raw);
+        }
+
+    private:
+        unsigned char *_bytes;
+        std::size_t _index;
+    };
+
+    template <typename S, std::size_t Bits>
+    struct is_strong_proxy<packed_reference<S, Bits>> : std::true_type
+    {
+    };
+
+    namespace details
+    {
+        /** Random access iterator over a packed_vector, yielding packed_reference or S by value if Const */
+        template <typename S, std::size_t Bits, bool Const>
+        class packed_iterator
+        {
+            using bytes_t = std::conditional_t<Const, const unsigned char *, unsigned char *>;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = S;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::conditional_t<Const, S, packed_reference<S, Bits>>;
+
+            packed_iterator() noexcept = default;
+
+            packed_iterator(bytes_t bytes, std::size_t index) noexcept : _bytes(bytes), _index(index)
+            {
+            }
+
+            template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+            packed_iterator(const packed_iterator<S, Bits, OtherConst> &other) noexcept :
+                _bytes(other._bytes), _index(other._index)
+            {
+            }
+
+            reference operator*() const
+            {
+                if constexpr (Const) {
+                    using codec = packed_codec<S, Bits>;
+
+                    return S(codec::decode(codec::load(_bytes, _index)));
+                } else {
+                    return reference(_bytes, _index);
+                }
+            }
+
+            reference operator[](difference_type n) const
+            {
+                return *(*this + n);
+            }
+
+            packed_iterator &operator++() noexcept
+            {
+                ++_index;
+                return *this;
+            }
+
+            packed_iterator operator++(int) noexcept
+            {
+                return packed_iterator(_bytes, _index++);
+            }
+
+            packed_iterator &operator--() noexcept
+            {
+                --_index;
+                return *this;
+            }
+
+            packed_iterator operator--(int) noexcept
+            {
+                return packed_iterator(_bytes, _index--);
+            }
+
+            packed_iterator &operator+=(difference_type n) noexcept
+            {
+                _index += static_cast<std::size_t>(n);
+                return *this;
+            }
+
+            packed_iterator &operator-=(difference_type n) noexcept
+            {
+                _index -= static_cast<std::size_t>(n);
+                return *this;
+            }
+
+            friend packed_iterator operator+(packed_iterator it, difference_type n) noexcept
+            {
+                return it += n;
+            }
+
+            friend packed_iterator operator+(difference_type n, packed_iterator it) noexcept
+            {
+                return it += n;
+            }
+
+            friend packed_iterator operator-(packed_iterator it, difference_type n) noexcept
+            {
+                return it -= n;
+            }
+
+            friend difference_type operator-(const packed_iterator &lhs, const packed_iterator &rhs) noexcept
+            {
+                return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+            }
+
+            friend bool operator==(const packed_iterator &lhs, const packed_iterator &rhs) noexcept
+            {
+                return lhs._index == rhs._index;
+            }
+
+            friend bool operator!=(const packed_iterator &lhs, const packed_iterator &rhs) noexcept
+            {
+                return lhs._index != rhs._index;
+            }
+
+            friend bool operator<(const packed_iterator &lhs, const packed_iterator &rhs) noexcept
+            {
+                return lhs._index < rhs._index;
+            }
+
+            friend bool operator>(const packed_iterator &lhs, const packed_iterator &rhs) noexcept
+            {
+                return lhs._index > rhs._index;
+            }
+
+            friend bool operator<=(const packed_iterator &lhs, const packed_iterator &rhs) noexcept
+            {
+                return lhs._index <= rhs._index;
+            }
+
+            friend bool operator>=(const packed_iterator &lhs, const packed_iterator &rhs) noexcept
+            {
+                return lhs._index >= rhs._index;
+            }
+
+        private:
+            template <typename, std::size_t, bool>
+            friend class packed_iterator;
+
+            bytes_t _bytes{nullptr};
+            std::size_t _index{0};
+        };
+
+        /** Whether unpacking Bits wide values into S can be done 8 values at a time with 32 bits lanes */
+        template <typename S, std::size_t Bits>
+        inline constexpr bool uses_packed_kernel_v =
+            is_layout_compatible_v<S> && Bits <= 25 && sizeof(typename S::value_type) <= 4;
+
+#if defined(STRONG_TYPE_PACKED_AVX2)
+        template <typename V>
+        inline void store_lanes(V *out, __m256i values) noexcept
+        {
+            if constexpr (sizeof(V) == 4) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), values);
+            } else {
+                /* Values are within the range of V, so saturating packs only narrow them */
+                const __m256i words = std::is_signed_v<V> ? _mm256_packs_epi32(values, values)
+                                                          : _mm256_packus_epi32(values, values);
+
+                if constexpr (sizeof(V) == 2) {
+                    const __m256i low = _mm256_permute4x64_epi64(words, 0x08);
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(low));
+                } else {
+                    const __m256i bytes = std::is_signed_v<V> ? _mm256_packs_epi16(words, words)
+                                                              : _mm256_packus_epi16(words, words);
+                    const __m256i low = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4));
+
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(low));
+                }
+            }
+        }
+
+        /**
+         * Unpacks values 8 at a time, returns the number of values written
+         *
+         * 8 values span exactly Bits bytes, so the bit offsets of the 8 lanes relative to the first byte of a group
+         * are the same for every group. Each half of a 256 bits register loads the 16 bytes starting at the first
+         * byte of its 4 values, which cover them as Bits <= 25, and shuffles the 4 bytes holding each value into its
+         * lane. Groups are processed as long as these loads stay before end.
+         */
+        template <typename S, std::size_t Bits>
+        inline std::size_t unpack_avx2(const unsigned char *bytes, const unsigned char *end, std::size_t first,
+                                       std::size_t count, typename S::value_type *out) noexcept
+        {
+            using codec = packed_codec<S, Bits>;
+
+            const std::size_t start = first * Bits;
+            const std::size_t phase = start % 8;
+            const std::size_t high = (4 * Bits + phase) / 8;
+            alignas(32) unsigned char positions[32];
+            alignas(32) int shifts[8];
+
+            for (std::size_t lane = 0; lane < 8; ++lane) {
+                const std::size_t pos = lane * Bits + phase;
+                const std::size_t byte = pos / 8 - (lane < 4 ? 0 : high);
+
+                for (std::size_t k = 0; k < 4; ++k)
+                    positions[lane * 4 + k] = static_cast<unsigned char>(byte + k);
+                shifts[lane] = static_cast<int>(pos % 8);
+            }
+
+            const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i *>(positions));
+            const __m256i shift = _mm256_load_si256(reinterpret_cast<const __m256i *>(shifts));
+            const __m256i mask = _mm256_set1_epi32(static_cast<int>(codec::mask));
+            const __m256i offset = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(codec::offset)));
+            const unsigned char *group = bytes + start / 8;
+            std::size_t i = 0;
+
+            for (; i + 8 <= count && group + high + 16 <= end; i += 8, group += Bits) {
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+                const __m128i upper = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group + high));
+                __m256i values = _mm256_inserti128_si256(_mm256_castsi128_si256(low), upper, 1);
+
+                values = _mm256_shuffle_epi8(values, shuffle);
+                values = _mm256_and_si256(_mm256_srlv_epi32(values, shift), mask);
+                store_lanes(out + i, _mm256_add_epi32(values, offset));
+            }
+            return i;
+        }
+#endif
+    }
+
+    /**
+     * Sequence of strong types stored in a dense bitstream of Bits bits per value
+     *
+     * Bits defaults to the width needed by the bounds of bounded types, for which values are stored relative to their
+     * lower bound: a bounded<13, 19, ...> takes 3 bits. Other strong types must have an unsigned underlying type, and
+     * default to all of its bits. Storing a value which does not fit in Bits throws std::out_of_range.
+     *
+     * Elements are accessed through packed_reference proxies, and const iteration yields values. unpack() decodes a
+     * range of elements into a span of strong types, using AVX2 when available.
+     */
+    template <typename S, std::size_t Bits = details::packed_bits_v<S>>
+    class packed_vector
+    {
+        static_assert(is_strong_type_v<S>, "st::packed_vector can only hold strong types");
+
+        using value_type_t = typename S::value_type;
+        using codec = details::packed_codec<S, Bits>;
+
+        static_assert(std::is_integral_v<value_type_t> && !std::is_same_v<value_type_t, bool>,
+                      "st::packed_vector requires an integral underlying type");
+        static_assert(details::has_bounds_v<S> || std::is_unsigned_v<value_type_t>,
+                      "st::packed_vector requires a bounded strong type or an unsigned underlying type");
+        static_assert(Bits >= 1 && Bits <= 57, "st::packed_vector supports 1 to 57 bits per value");
+
+    public:
+        using value_type = S;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = packed_reference<S, Bits>;
+        using const_reference = S;
+        using iterator = details::packed_iterator<S, Bits, false>;
+        using const_iterator = details::packed_iterator<S, Bits, true>;
+
+        static constexpr std::size_t bits_per_value = Bits;
+
+        packed_vector() noexcept = default;
+
+        explicit packed_vector(size_type count)
+        {
+            resize(count);
+        }
+
+        packed_vector(size_type count, const S &value)
+        {
+            resize(count, value);
+        }
+
+        packed_vector(std::initializer_list<S> values)
+        {
+            reserve(values.size());
+            for (const auto &v : values)
+                push_back(v);
+        }
+
+        reference operator[](size_type pos) noexcept
+        {
+            return reference(_bytes(), pos);
+        }
+
+        const_reference operator[](size_type pos) const
+        {
+            return S(codec::decode(codec::load(_bytes(), pos)));
+        }
+
+        reference at(size_type pos)
+        {
+            if (pos >= size())
+                throw std::out_of_range("st::packed_vector::at: index out of range");
+            return (*this)[pos];
+        }
+
+        const_reference at(size_type pos) const
+        {
+            if (pos >= size())
+                throw std::out_of_range("st::packed_vector::at: index out of range");
+            return (*this)[pos];
+        }
+
+        reference front() noexcept
+        {
+            return (*this)[0];
+        }
+
+        const_reference front() const
+        {
+            return (*this)[0];
+        }
+
+        reference back() noexcept
+        {
+            return (*this)[_size - 1];
+        }
+
+        const_reference back() const
+        {
+            return (*this)[_size - 1];
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(_bytes(), 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(_bytes(), 0);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(_bytes(), _size);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(_bytes(), _size);
+        }
+
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return _words.capacity() == 0 ? 0 : (_words.capacity() - 1) * 64 / Bits;
+        }
+
+        /** Bytes allocated to hold the values */
+        size_type memory_usage() const noexcept
+        {
+            return _words.capacity() * sizeof(std::uint64_t);
+        }
+
+        void reserve(size_type count)
+        {
+            _words.reserve(_words_for(count));
+        }
+
+        void shrink_to_fit()
+        {
+            _words.resize(_words_for(_size));
+            _words.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            _words.clear();
+            _size = 0;
+        }
+
+        void resize(size_type count)
+        {
+            resize(count, S());
+        }
+
+        void resize(size_type count, const S &value)
+        {
+            const auto raw = codec::encode(value);
+
+            _words.resize(_words_for(count));
+            for (size_type i = _size; i < count; ++i)
+                codec::store(_bytes(), i, raw);
+            _size = count;
+        }
+
+        void push_back(const S &value)
+        {
+            const auto raw = codec::encode(value);
+
+            _words.resize(_words_for(_size + 1));
+            codec::store(_bytes(), _size++, raw);
+        }
+
+        void pop_back() noexcept
+        {
+            --_size;
+        }
+
+        /** Decodes the out.size() elements starting at first into out */
+        void unpack(size_type first, span<S> out) const noexcept
+        {
+            assert(first + out.size() <= size());
+            if constexpr (is_layout_compatible_v<S>) {
+                auto *raw = reinterpret_cast<value_type_t *>(out.data());
+                size_type i = 0;
+
+#if defined(STRONG_TYPE_PACKED_AVX2)
+                if constexpr (details::uses_packed_kernel_v<S, Bits>)
+                    i = details::unpack_avx2<S, Bits>(_bytes(), _bytes() + _words.size() * sizeof(std::uint64_t),
+                                                      first, out.size(), raw);
+#endif
+                for (; i < out.size(); ++i)
+                    raw[i] = codec::decode(codec::load(_bytes(), first + i));
+            } else {
+                for (size_type i = 0; i < out.size(); ++i)
+                    out[i] = (*this)[first + i];
+            }
+        }
+
+        friend bool operator==(const packed_vector &lhs, const packed_vector &rhs) noexcept
+        {
+            if (lhs.size() != rhs.size())
+                return false;
+            for (size_type i = 0; i < lhs.size(); ++i) {
+                if (codec::load(lhs._bytes(), i) != codec::load(rhs._bytes(), i))
+                    return false;
+            }
+            return true;
+        }
+
+        friend bool operator!=(const packed_vector &lhs, const packed_vector &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        /** Words holding count values, plus one so that reading 8 bytes from the start of any value stays in bounds */
+        static size_type _words_for(size_type count) noexcept
+        {
+            return (count * Bits + 63) / 64 + 1;
+        }
+
+        unsigned char *_bytes() noexcept
+        {
+            return reinterpret_cast<unsigned char *>(_words.data());
+        }
+
+        const unsigned char *_bytes() const noexcept
+        {
+            return reinterpret_cast<const unsigned char *>(_words.data());
+        }
+
+        std::vector<std::uint64_t> _words;
+        size_type _size{0};
+    };
+}
+
+#endif /* !STRONG_TYPE_PACKED_VECTOR_HPP */
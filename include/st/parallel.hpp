@@ -0,0 +1,436 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_PARALLEL_HPP
+#define STRONG_TYPE_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <st/batch.hpp>
+
+#if !defined(STRONG_TYPE_CACHE_LINE_SIZE)
+#define STRONG_TYPE_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * Reductions and scans over contiguous ranges of strong types, spread over the threads of a thread_pool
+ *
+ * As with st::batch, every operation is only available if the strong type carries the corresponding trait, and its
+ * result is a strong type. Ranges are cut into tasks whose boundaries only depend on the size of the range, and
+ * partial results are combined in order, so that results do not depend on the number of threads, even for floating
+ * point values. They may however round differently from a sequential loop.
+ */
+namespace st::parallel
+{
+    namespace details
+    {
+        template <typename Range>
+        using strong_t = batch::details::strong_t<Range>;
+
+        /** Whether the calling thread is running a task, in which case nested operations run sequentially */
+        inline thread_local bool inside_task = false;
+
+        /** Tasks owned by a participant, which the others steal once they are done with their own */
+        struct alignas(STRONG_TYPE_CACHE_LINE_SIZE) task_cursor
+        {
+            std::atomic<std::size_t> next{0};
+            std::size_t end = 0;
+            char padding[STRONG_TYPE_CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+        };
+
+        struct job
+        {
+            using function = void (*)(void *context, std::size_t task, std::size_t participant);
+
+            job(function f, void *data, std::size_t count) :
+                run(f), context(data), cursors(std::make_unique<task_cursor[]>(count)), participants(count)
+            {
+            }
+
+            function run;
+            void *context;
+            std::unique_ptr<task_cursor[]> cursors;
+            std::size_t participants;
+            std::atomic<std::size_t> failures{0};
+            std::exception_ptr error;
+        };
+
+        inline std::size_t default_concurrency() noexcept
+        {
+            return std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        /** Ranges are cut into tasks of at least this many elements... */
+        inline constexpr std::size_t min_task_size = std::size_t(1) << 15;
+
+        /** ...but into no more than this many tasks, which is enough to balance the load over many threads */
+        inline constexpr std::size_t max_tasks = 1024;
+
+        inline std::size_t task_count(std::size_t n) noexcept
+        {
+            return std::min(max_tasks, (n + min_task_size - 1) / min_task_size);
+        }
+
+        template <typename S>
+        inline span<S> task_range(S *data, std::size_t n, std::size_t task, std::size_t tasks) noexcept
+        {
+            return span<S>(data + n * task / tasks, data + n * (task + 1) / tasks);
+        }
+    }
+
+    /**
+     * Fixed set of threads running the tasks of one operation at a time
+     *
+     * The tasks of an operation are split evenly between the calling thread and the workers, and each of them steals
+     * tasks from the others once it is done with its own. Operations submitted by several threads are run one after
+     * the other, and operations submitted from a task run sequentially in the calling thread.
+     */
+    class thread_pool
+    {
+    public:
+        /** Creates a pool running operations over concurrency threads, including the calling thread */
+        explicit thread_pool(std::size_t concurrency = details::default_concurrency())
+        {
+            const std::size_t workers = concurrency > 1 ? concurrency - 1 : 0;
+
+            _workers.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i)
+                _workers.emplace_back([this, i] { _work(i + 1); });
+        }
+
+        thread_pool(const thread_pool &) = delete;
+
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                /* Publishing no job tells the workers to exit */
+                _job = nullptr;
+                ++_generation;
+            }
+            _wake.notify_all();
+            for (auto &worker : _workers)
+                worker.join();
+        }
+
+        std::size_t concurrency() const noexcept
+        {
+            return _workers.size() + 1;
+        }
+
+        /**
+         * Calls f(task, participant) for every task in [0, tasks), and returns once all calls returned
+         *
+         * participant is the index, below concurrency(), of the thread making the call. If calls throw, the remaining
+         * tasks are skipped and the first exception is rethrown.
+         */
+        template <typename F>
+        void run(std::size_t tasks, F &&f)
+        {
+            if (_workers.empty() || tasks <= 1 || details::inside_task) {
+                for (std::size_t task = 0; task < tasks; ++task)
+                    f(task, std::size_t(0));
+                return;
+            }
+
+            std::lock_guard<std::mutex> submit_lock(_submit);
+            auto call = [&f](std::size_t task, std::size_t participant) { f(task, participant); };
+            details::job job([](void *context, std::size_t task, std::size_t participant) {
+                (*static_cast<decltype(call) *>(context))(task, participant);
+            }, &call, concurrency());
+
+            for (std::size_t p = 0; p < job.participants; ++p) {
+                job.cursors[p].next.store(tasks * p / job.participants, std::memory_order_relaxed);
+                job.cursors[p].end = tasks * (p + 1) / job.participants;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                _job = &job;
+                _finished = 0;
+                ++_generation;
+            }
+            _wake.notify_all();
+            _participate(job, 0);
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+
+                _done.wait(lock, [this] { return _finished == _workers.size(); });
+                _job = nullptr;
+            }
+            if (job.error)
+                std::rethrow_exception(job.error);
+        }
+
+    private:
+        static void _participate(details::job &job, std::size_t participant) noexcept
+        {
+            details::inside_task = true;
+            for (std::size_t i = 0; i < job.participants; ++i) {
+                details::task_cursor &cursor = job.cursors[(participant + i) % job.participants];
+
+                for (;;) {
+                    const std::size_t task = cursor.next.fetch_add(1, std::memory_order_relaxed);
+
+                    if (task >= cursor.end || job.failures.load(std::memory_order_relaxed) != 0)
+                        break;
+                    try {
+                        job.run(job.context, task, participant);
+                    } catch (...) {
+                        if (job.failures.fetch_add(1, std::memory_order_relaxed) == 0)
+                            job.error = std::current_exception();
+                    }
+                }
+            }
+            details::inside_task = false;
+        }
+
+        void _work(std::size_t participant)
+        {
+            std::uint64_t seen = 0;
+
+            for (;;) {
+                details::job *job;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+
+                    _wake.wait(lock, [this, seen] { return _generation != seen; });
+                    seen = _generation;
+                    job = _job;
+                }
+                if (job == nullptr)
+                    return;
+                _participate(*job, participant);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    if (++_finished == _workers.size())
+                        _done.notify_one();
+                }
+            }
+        }
+
+        std::mutex _submit;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        details::job *_job = nullptr;
+        std::uint64_t _generation = 0;
+        std::size_t _finished = 0;
+        std::vector<std::thread> _workers;
+    };
+
+    /** Pool used by the operations which are not given one, with a thread per hardware thread */
+    inline thread_pool &default_pool()
+    {
+        static thread_pool pool;
+
+        return pool;
+    }
+
+    /** Sum of all the elements of the range, starting from init */
+    template <typename InRange, typename S = details::strong_t<const InRange>>
+    S reduce(thread_pool &pool, const InRange &in, S init = S())
+    {
+        static_assert(std::is_same_v<S, details::strong_t<const InRange>>, "init must have the type of the elements");
+        static_assert(std::is_base_of_v<traits::addable<S>, S>, "parallel::reduce requires the addable trait");
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        const std::size_t tasks = details::task_count(n);
+        std::vector<S> partials(tasks);
+
+        pool.run(tasks, [&](std::size_t task, std::size_t) {
+            partials[task] = batch::sum(details::task_range(a, n, task, tasks));
+        });
+        for (const S &partial : partials)
+            init = init + partial;
+        return init;
+    }
+
+    template <typename InRange, typename S = details::strong_t<const InRange>>
+    S reduce(const InRange &in, S init = S())
+    {
+        return parallel::reduce(default_pool(), in, init);
+    }
+
+    /** Smallest element of a non-empty range */
+    template <typename InRange>
+    details::strong_t<const InRange> min(thread_pool &pool, const InRange &in)
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_base_of_v<traits::orderable<S>, S>, "parallel::min requires the orderable trait");
+        assert(std::size(in) != 0);
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        const std::size_t tasks = details::task_count(n);
+        std::vector<S> partials(tasks, a[0]);
+
+        pool.run(tasks, [&](std::size_t task, std::size_t) {
+            partials[task] = batch::min(details::task_range(a, n, task, tasks));
+        });
+        return *std::min_element(partials.begin(), partials.end());
+    }
+
+    template <typename InRange>
+    details::strong_t<const InRange> min(const InRange &in)
+    {
+        return parallel::min(default_pool(), in);
+    }
+
+    /** Largest element of a non-empty range */
+    template <typename InRange>
+    details::strong_t<const InRange> max(thread_pool &pool, const InRange &in)
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_base_of_v<traits::orderable<S>, S>, "parallel::max requires the orderable trait");
+        assert(std::size(in) != 0);
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        const std::size_t tasks = details::task_count(n);
+        std::vector<S> partials(tasks, a[0]);
+
+        pool.run(tasks, [&](std::size_t task, std::size_t) {
+            partials[task] = batch::max(details::task_range(a, n, task, tasks));
+        });
+        return *std::max_element(partials.begin(), partials.end());
+    }
+
+    template <typename InRange>
+    details::strong_t<const InRange> max(const InRange &in)
+    {
+        return parallel::max(default_pool(), in);
+    }
+
+    /** Sum of transform(x) for all the elements x of the range, starting from init */
+    template <typename InRange, typename R, typename TransformOp>
+    R transform_reduce(thread_pool &pool, const InRange &in, R init, TransformOp transform)
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_base_of_v<traits::addable<R>, R>,
+                      "parallel::transform_reduce requires a result type with the addable trait");
+        static_assert(std::is_constructible_v<R, std::invoke_result_t<TransformOp &, const S &>>,
+                      "transform must return the type of the result");
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        const std::size_t tasks = details::task_count(n);
+        std::vector<R> partials(tasks, init);
+
+        pool.run(tasks, [&](std::size_t task, std::size_t) {
+            const auto range = details::task_range(a, n, task, tasks);
+            R acc(transform(range[0]));
+
+            for (std::size_t i = 1; i < range.size(); ++i)
+                acc = acc + R(transform(range[i]));
+            partials[task] = acc;
+        });
+        for (const R &partial : partials)
+            init = init + partial;
+        return init;
+    }
+
+    template <typename InRange, typename R, typename TransformOp>
+    R transform_reduce(const InRange &in, R init, TransformOp transform)
+    {
+        return parallel::transform_reduce(default_pool(), in, std::move(init), std::move(transform));
+    }
+
+    /** Number of elements x of the range for which bucket_of(x) is i, for every i below buckets */
+    template <typename InRange, typename BucketOp>
+    std::vector<std::size_t> histogram(thread_pool &pool, const InRange &in, std::size_t buckets, BucketOp bucket_of)
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_invocable_r_v<std::size_t, BucketOp &, const S &>, "bucket_of must return an index");
+
+        const S *a = std::data(in);
+        const std::size_t n = std::size(in);
+        const std::size_t tasks = details::task_count(n);
+        std::vector<std::vector<std::size_t>> counts(pool.concurrency(), std::vector<std::size_t>(buckets));
+
+        pool.run(tasks, [&](std::size_t task, std::size_t participant) {
+            std::vector<std::size_t> &local = counts[participant];
+
+            for (const S &x : details::task_range(a, n, task, tasks)) {
+                const std::size_t bucket = bucket_of(x);
+
+                assert(bucket < buckets);
+                ++local[bucket];
+            }
+        });
+        for (std::size_t p = 1; p < counts.size(); ++p) {
+            for (std::size_t i = 0; i < buckets; ++i)
+                counts[0][i] += counts[p][i];
+        }
+        return std::move(counts[0]);
+    }
+
+    template <typename InRange, typename BucketOp>
+    std::vector<std::size_t> histogram(const InRange &in, std::size_t buckets, BucketOp bucket_of)
+    {
+        return parallel::histogram(default_pool(), in, buckets, std::move(bucket_of));
+    }
+
+    /** out[i] = in[0] + ... + in[i], out may be in */
+    template <typename InRange, typename OutRange>
+    void prefix_sum(thread_pool &pool, const InRange &in, OutRange &&out)
+    {
+        using S = details::strong_t<const InRange>;
+
+        static_assert(std::is_same_v<S, details::strong_t<OutRange>>, "output must have the type of the elements");
+        static_assert(std::is_base_of_v<traits::addable<S>, S>, "parallel::prefix_sum requires the addable trait");
+        assert(std::size(out) >= std::size(in));
+
+        const S *a = std::data(in);
+        S *o = std::data(out);
+        const std::size_t n = std::size(in);
+        const std::size_t tasks = details::task_count(n);
+        std::vector<S> offsets(tasks);
+
+        /* Sums each task, then scans each task again starting from the sum of the tasks before it */
+        pool.run(tasks, [&](std::size_t task, std::size_t) {
+            offsets[task] = batch::sum(details::task_range(a, n, task, tasks));
+        });
+        for (std::size_t task = 1; task < tasks; ++task)
+            offsets[task] = offsets[task - 1] + offsets[task];
+        pool.run(tasks, [&](std::size_t task, std::size_t) {
+            const std::size_t first = n * task / tasks;
+            const std::size_t last = n * (task + 1) / tasks;
+            S acc = task == 0 ? a[first] : offsets[task - 1] + a[first];
+
+            o[first] = acc;
+            for (std::size_t i = first + 1; i < last; ++i) {
+                acc = acc + a[i];
+                o[i] = acc;
+            }
+        });
+    }
+
+    template <typename InRange, typename OutRange>
+    void prefix_sum(const InRange &in, OutRange &&out)
+    {
+        parallel::prefix_sum(default_pool(), in, std::forward<OutRange>(out));
+    }
+}
+
+#endif /* !STRONG_TYPE_PARALLEL_HPP */
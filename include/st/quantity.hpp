@@ -0,0 +1,364 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_QUANTITY_HPP
+#define STRONG_TYPE_QUANTITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+#include <st/type.hpp>
+
+namespace st
+{
+    /**
+     * Dimension of a quantity, as the exponents of each base dimension
+     *
+     * Trailing zero exponents are not significant: quantities normalize dimension<1, 0> to dimension<1>.
+     */
+    template <std::intmax_t ...Exponents>
+    struct dimension
+    {
+        static constexpr std::size_t rank = sizeof...(Exponents);
+
+        static constexpr std::intmax_t exponent(std::size_t i) noexcept
+        {
+            constexpr std::intmax_t exponents[] = {Exponents..., 0};
+
+            return i < rank ? exponents[i] : 0;
+        }
+    };
+
+    namespace details
+    {
+        template <typename D>
+        constexpr std::size_t trimmed_rank() noexcept
+        {
+            std::size_t rank = D::rank;
+
+            while (rank > 0 && D::exponent(rank - 1) == 0)
+                --rank;
+            return rank;
+        }
+
+        template <typename D, typename = std::make_index_sequence<trimmed_rank<D>()>>
+        struct trim_dimension;
+
+        template <typename D, std::size_t ...I>
+        struct trim_dimension<D, std::index_sequence<I...>>
+        {
+            using type = dimension<D::exponent(I)...>;
+        };
+
+        template <typename D1, typename D2, std::intmax_t Sign,
+            typename = std::make_index_sequence<(D1::rank > D2::rank ? D1::rank : D2::rank)>>
+        struct combine_dimensions;
+
+        template <typename D1, typename D2, std::intmax_t Sign, std::size_t ...I>
+        struct combine_dimensions<D1, D2, Sign, std::index_sequence<I...>>
+        {
+            using type = typename trim_dimension<dimension<(D1::exponent(I) + Sign * D2::exponent(I))...>>::type;
+        };
+    }
+
+    template <typename D1, typename D2>
+    using dimension_multiply_t = typename details::combine_dimensions<D1, D2, 1>::type;
+
+    template <typename D1, typename D2>
+    using dimension_divide_t = typename details::combine_dimensions<D1, D2, -1>::type;
+
+    /** Base dimensions, in the order of the SI followed by information, and a few derived ones */
+    namespace dimensions
+    {
+        using scalar = dimension<>;
+        using length = dimension<1>;
+        using mass = dimension<0, 1>;
+        using time = dimension<0, 0, 1>;
+        using current = dimension<0, 0, 0, 1>;
+        using temperature = dimension<0, 0, 0, 0, 1>;
+        using amount = dimension<0, 0, 0, 0, 0, 1>;
+        using luminous_intensity = dimension<0, 0, 0, 0, 0, 0, 1>;
+        using information = dimension<0, 0, 0, 0, 0, 0, 0, 1>;
+
+        using area = dimension_multiply_t<length, length>;
+        using velocity = dimension_divide_t<length, time>;
+        using acceleration = dimension_divide_t<velocity, time>;
+        using frequency = dimension_divide_t<scalar, time>;
+        using data_rate = dimension_divide_t<information, time>;
+    }
+
+    namespace traits
+    {
+        template <typename T>
+        struct quantity_arithmetic;
+    }
+
+    /** Trait giving quantities their arithmetic, see quantity */
+    struct quantity_arithmetic
+    {
+        template <typename T>
+        using type = traits::quantity_arithmetic<T>;
+    };
+
+    namespace details
+    {
+        template <typename Dim, typename Ratio>
+        struct quantity_tag
+        {
+        };
+
+        template <typename Rep, typename Dim, typename Ratio>
+        using quantity_type = type<Rep, quantity_tag<Dim, Ratio>, st::quantity_arithmetic>;
+
+        /** Ratio both R1 and R2 are integral multiples of, as for std::chrono::duration */
+        template <typename R1, typename R2>
+        using common_ratio_t = typename std::ratio<std::gcd(R1::num, R2::num), std::lcm(R1::den, R2::den)>::type;
+
+        /**
+         * Multiplies v by the compile-time constant Factor, converting it to ToRep
+         *
+         * Floating point values are multiplied by the folded factor, which may differ in its last bit from dividing
+         * by the denominator. Integral values are computed in at least std::intmax_t, multiplied by the numerator and
+         * divided by the denominator, each step being skipped when it is 1.
+         */
+        template <typename ToRep, typename Factor, typename Rep>
+        constexpr ToRep scale(const Rep &v) noexcept
+        {
+            using common_t = std::common_type_t<ToRep, Rep, std::intmax_t>;
+
+            if constexpr (Factor::num == 1 && Factor::den == 1) {
+                return static_cast<ToRep>(v);
+            } else if constexpr (std::is_floating_point_v<common_t>) {
+                constexpr common_t factor = static_cast<common_t>(Factor::num) / static_cast<common_t>(Factor::den);
+
+                return static_cast<ToRep>(static_cast<common_t>(v) * factor);
+            } else if constexpr (Factor::den == 1) {
+                return static_cast<ToRep>(static_cast<common_t>(v) * Factor::num);
+            } else if constexpr (Factor::num == 1) {
+                return static_cast<ToRep>(static_cast<common_t>(v) / Factor::den);
+            } else {
+                return static_cast<ToRep>(static_cast<common_t>(v) * Factor::num / Factor::den);
+            }
+        }
+
+        /** Whether converting from Ratio to ToRatio is exact, which it always is for floating point ToRep */
+        template <typename ToRep, typename Ratio, typename ToRatio>
+        inline constexpr bool is_exact_conversion_v =
+            std::is_floating_point_v<ToRep> || std::ratio_divide<Ratio, ToRatio>::den == 1;
+    }
+
+    /**
+     * Strong type holding an amount of Dim, counted in units of Ratio
+     *
+     * Quantities are distinguished by their dimension and scale. Multiplying or dividing quantities returns the
+     * quantity whose dimension and ratio are derived from those of the operands, without any scaling:
+     * meters / milliseconds is a quantity of velocity counted in std::kilo units. Quantities of the same dimension
+     * can be added, subtracted and compared: when their ratios differ, both are converted to their common ratio, as
+     * for std::chrono::duration. Converting to another ratio is explicit through quantity_cast, and costs at most a
+     * single multiplication by a factor folded at compile time.
+     */
+    template <typename Rep, typename Dim, typename Ratio = std::ratio<1>>
+    using quantity = details::quantity_type<Rep, typename details::trim_dimension<Dim>::type, typename Ratio::type>;
+
+    template <typename T>
+    struct is_quantity : std::false_type
+    {
+    };
+
+    template <typename Rep, typename Dim, typename Ratio>
+    struct is_quantity<details::quantity_type<Rep, Dim, Ratio>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    inline constexpr const bool is_quantity_v = is_quantity<T>::value;
+
+    /** Converts q to the quantity To, which must have the same dimension */
+    template <typename To, typename Rep, typename Dim, typename Ratio>
+    constexpr To quantity_cast(const details::quantity_type<Rep, Dim, Ratio> &q) noexcept
+    {
+        static_assert(is_quantity_v<To>, "st::quantity_cast can only convert to quantities");
+        static_assert(std::is_same_v<typename To::dimension_type, Dim>,
+                      "st::quantity_cast cannot convert between different dimensions");
+
+        using factor = std::ratio_divide<Ratio, typename To::ratio_type>;
+
+        return To(details::scale<typename To::value_type, factor>(q.value()));
+    }
+
+    namespace traits
+    {
+        template <typename Rep, typename Dim, typename Ratio>
+        struct quantity_arithmetic<details::quantity_type<Rep, Dim, Ratio>>
+        {
+            static_assert(std::is_arithmetic_v<Rep>, "quantities require an arithmetic representation");
+
+            using T = details::quantity_type<Rep, Dim, Ratio>;
+            using dimension_type = Dim;
+            using ratio_type = Ratio;
+
+            template <typename OtherRep, typename OtherRatio>
+            using same_dimension = details::quantity_type<OtherRep, Dim, OtherRatio>;
+
+            template <typename OtherRep, typename OtherRatio>
+            using common_t = details::quantity_type<std::common_type_t<Rep, OtherRep>, Dim,
+                                                    details::common_ratio_t<Ratio, OtherRatio>>;
+
+            template <typename Scalar>
+            using scaled_t = details::quantity_type<std::common_type_t<Rep, Scalar>, Dim, Ratio>;
+
+            friend constexpr T operator+(const T &t) noexcept
+            {
+                return t;
+            }
+
+            friend constexpr T operator-(const T &t) noexcept
+            {
+                return T(static_cast<Rep>(-t.value()));
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr common_t<OtherRep, OtherRatio> operator+(
+                const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                using R = common_t<OtherRep, OtherRatio>;
+
+                return R(quantity_cast<R>(lhs).value() + quantity_cast<R>(rhs).value());
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr common_t<OtherRep, OtherRatio> operator-(
+                const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                using R = common_t<OtherRep, OtherRatio>;
+
+                return R(quantity_cast<R>(lhs).value() - quantity_cast<R>(rhs).value());
+            }
+
+            template <typename OtherRep, typename OtherRatio, typename = std::enable_if_t<
+                details::is_exact_conversion_v<Rep, OtherRatio, Ratio>
+            >>
+            friend constexpr T &operator+=(T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                lhs.value() += quantity_cast<T>(rhs).value();
+                return lhs;
+            }
+
+            template <typename OtherRep, typename OtherRatio, typename = std::enable_if_t<
+                details::is_exact_conversion_v<Rep, OtherRatio, Ratio>
+            >>
+            friend constexpr T &operator-=(T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                lhs.value() -= quantity_cast<T>(rhs).value();
+                return lhs;
+            }
+
+            template <typename OtherRep, typename OtherDim, typename OtherRatio>
+            friend constexpr auto operator*(const T &lhs,
+                                            const details::quantity_type<OtherRep, OtherDim, OtherRatio> &rhs) noexcept
+            {
+                using R = details::quantity_type<std::common_type_t<Rep, OtherRep>, dimension_multiply_t<Dim, OtherDim>,
+                                                 std::ratio_multiply<Ratio, OtherRatio>>;
+
+                return R(lhs.value() * rhs.value());
+            }
+
+            template <typename OtherRep, typename OtherDim, typename OtherRatio>
+            friend constexpr auto operator/(const T &lhs,
+                                            const details::quantity_type<OtherRep, OtherDim, OtherRatio> &rhs) noexcept
+            {
+                using R = details::quantity_type<std::common_type_t<Rep, OtherRep>, dimension_divide_t<Dim, OtherDim>,
+                                                 std::ratio_divide<Ratio, OtherRatio>>;
+
+                return R(lhs.value() / rhs.value());
+            }
+
+            template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+            friend constexpr scaled_t<Scalar> operator*(const T &lhs, const Scalar &rhs) noexcept
+            {
+                return scaled_t<Scalar>(lhs.value() * rhs);
+            }
+
+            template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+            friend constexpr scaled_t<Scalar> operator*(const Scalar &lhs, const T &rhs) noexcept
+            {
+                return scaled_t<Scalar>(lhs * rhs.value());
+            }
+
+            template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+            friend constexpr scaled_t<Scalar> operator/(const T &lhs, const Scalar &rhs) noexcept
+            {
+                return scaled_t<Scalar>(lhs.value() / rhs);
+            }
+
+            template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+            friend constexpr auto operator/(const Scalar &lhs, const T &rhs) noexcept
+            {
+                using R = details::quantity_type<std::common_type_t<Rep, Scalar>, dimension_divide_t<dimension<>, Dim>,
+                                                 std::ratio_divide<std::ratio<1>, Ratio>>;
+
+                return R(lhs / rhs.value());
+            }
+
+            template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+            friend constexpr T &operator*=(T &lhs, const Scalar &rhs) noexcept
+            {
+                lhs.value() *= rhs;
+                return lhs;
+            }
+
+            template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic_v<Scalar>>>
+            friend constexpr T &operator/=(T &lhs, const Scalar &rhs) noexcept
+            {
+                lhs.value() /= rhs;
+                return lhs;
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr bool operator==(const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                using R = common_t<OtherRep, OtherRatio>;
+
+                return quantity_cast<R>(lhs).value() == quantity_cast<R>(rhs).value();
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr bool operator!=(const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr bool operator<(const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                using R = common_t<OtherRep, OtherRatio>;
+
+                return quantity_cast<R>(lhs).value() < quantity_cast<R>(rhs).value();
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr bool operator>(const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                return rhs < lhs;
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr bool operator<=(const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                return !(rhs < lhs);
+            }
+
+            template <typename OtherRep, typename OtherRatio>
+            friend constexpr bool operator>=(const T &lhs, const same_dimension<OtherRep, OtherRatio> &rhs) noexcept
+            {
+                return !(lhs < rhs);
+            }
+        };
+    }
+}
+
+#endif /* !STRONG_TYPE_QUANTITY_HPP */
@@ -0,0 +1,124 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_RELOCATE_HPP
+#define STRONG_TYPE_RELOCATE_HPP
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <st/traits.hpp>
+
+namespace st
+{
+    /**
+     * Whether moving a T to another address and destroying the source can be done by copying its bytes
+     *
+     * This holds for trivially copyable types, for a few standard library types known to be relocatable, for strong
+     * types wrapping a trivially relocatable type, and for types having the trivially_relocatable trait. Other types
+     * can opt in by specializing is_trivially_relocatable.
+     */
+    template <typename T>
+    struct is_trivially_relocatable;
+
+    namespace details
+    {
+        template <typename T>
+        struct is_known_relocatable : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_known_relocatable<std::unique_ptr<T, std::default_delete<T>>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct is_known_relocatable<std::shared_ptr<T>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct is_known_relocatable<std::weak_ptr<T>> : std::true_type
+        {
+        };
+
+#if !defined(_MSC_VER) || (defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL == 0)
+        /** MSVC's checked iterators keep a pointer back to the container */
+        template <typename T>
+        struct is_known_relocatable<std::vector<T, std::allocator<T>>> : std::true_type
+        {
+        };
+#endif
+
+#if defined(_LIBCPP_VERSION)
+        /** libstdc++'s small string optimization makes std::string point to itself, libc++'s does not */
+        template <typename CharT, typename TraitsT>
+        struct is_known_relocatable<std::basic_string<CharT, TraitsT, std::allocator<CharT>>> : std::true_type
+        {
+        };
+#endif
+
+        /** Strong types using the default storage are laid out exactly as their underlying type */
+        template <typename T, typename Tag, typename ...Traits>
+        struct is_known_relocatable<type<T, Tag, Traits...>> : std::bool_constant<
+            std::is_same_v<storage_t<T, Traits...>, type_base<T>> && is_trivially_relocatable<T>::value
+        >
+        {
+        };
+    }
+
+    template <typename T>
+    struct is_trivially_relocatable : std::bool_constant<
+        std::is_trivially_copyable_v<T> ||
+        std::is_base_of_v<traits::trivially_relocatable<T>, T> ||
+        details::is_known_relocatable<std::remove_cv_t<T>>::value
+    >
+    {
+    };
+
+    template <typename T>
+    inline constexpr const bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    /**
+     * Moves the objects of [first, last) to the uninitialized memory starting at dest, and ends their lifetime
+     *
+     * Trivially relocatable objects are moved with a single memmove, so the ranges may overlap. Other objects are
+     * move-constructed then destroyed one by one, so dest must not overlap with [first, last).
+     */
+    template <typename T>
+    T *relocate(T *first, T *last, T *dest) noexcept
+    {
+        static_assert(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>,
+                      "relocating requires a trivially relocatable or nothrow move constructible type");
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            const auto count = static_cast<std::size_t>(last - first);
+
+            if (count != 0)
+                std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), count * sizeof(T));
+            return dest + count;
+        } else {
+            for (; first != last; ++first, ++dest) {
+                ::new (static_cast<void *>(dest)) T(std::move(*first));
+                first->~T();
+            }
+            return dest;
+        }
+    }
+
+    /** Relocates a single object from src to the uninitialized memory at dest */
+    template <typename T>
+    T *relocate_at(T *src, T *dest) noexcept
+    {
+        relocate(src, src + 1, dest);
+        return dest;
+    }
+}
+
+#endif /* !STRONG_TYPE_RELOCATE_HPP */
@@ -0,0 +1,148 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_SHARDED_HPP
+#define STRONG_TYPE_SHARDED_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <st/atomic.hpp>
+
+#if !defined(STRONG_TYPE_CACHE_LINE_SIZE)
+#define STRONG_TYPE_CACHE_LINE_SIZE 64
+#endif
+
+namespace st
+{
+    namespace details
+    {
+        /** Index of the calling thread, handed out round-robin the first time a thread asks for it */
+        inline std::size_t this_thread_shard() noexcept
+        {
+            static std::atomic<std::size_t> next{0};
+            thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+
+            return index;
+        }
+
+        inline std::size_t default_shard_count() noexcept
+        {
+            return std::thread::hardware_concurrency();
+        }
+    }
+
+    /**
+     * Counter holding a strong type S, split into one cache line per shard
+     *
+     * Each thread always updates the same shard, so threads spread over different shards never write to the same cache
+     * line. Reading the counter sums all shards, which is not atomic with respect to concurrent updates: load()
+     * returns a value the counter had at some point only once updates have stopped.
+     *
+     * += and -= require S to be addable or add_assignable, respectively subtractable or subtract_assignable, ++
+     * requires incrementable and -- requires decrementable. The underlying type of S must be integral.
+     */
+    template <typename S>
+    class sharded
+    {
+        static_assert(is_strong_type_v<S>, "st::sharded can only hold strong types");
+
+        using value_type_t = typename S::value_type;
+
+        static_assert(std::is_integral_v<value_type_t>, "st::sharded requires an integral underlying type");
+        static_assert(std::atomic<value_type_t>::is_always_lock_free,
+                      "st::sharded requires a lock-free underlying type");
+
+    public:
+        using value_type = S;
+
+        /** Creates a counter with one shard per hardware thread by default, rounded up to a power of two */
+        explicit sharded(std::size_t shards = details::default_shard_count()) :
+            _mask(_round_up(shards) - 1), _slots(new slot[_mask + 1])
+        {
+        }
+
+        std::size_t shard_count() const noexcept
+        {
+            return _mask + 1;
+        }
+
+        /** Sum of all shards */
+        S load() const noexcept
+        {
+            value_type_t sum = value_type_t();
+
+            for (std::size_t i = 0; i <= _mask; ++i)
+                sum += _slots[i].value.load(std::memory_order_relaxed);
+            return S(sum);
+        }
+
+        /** Sets all shards to zero, concurrent updates may or may not be lost */
+        void reset() noexcept
+        {
+            for (std::size_t i = 0; i <= _mask; ++i)
+                _slots[i].value.store(value_type_t(), std::memory_order_relaxed);
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::addable, traits::add_assignable, S, U>
+        >>
+        sharded &operator+=(const U &arg) noexcept
+        {
+            _local().fetch_add(static_cast<value_type_t>(unwrap(arg)), std::memory_order_relaxed);
+            return *this;
+        }
+
+        template <typename U, typename = std::enable_if_t<
+            details::has_atomic_operation_v<traits::subtractable, traits::subtract_assignable, S, U>
+        >>
+        sharded &operator-=(const U &arg) noexcept
+        {
+            _local().fetch_sub(static_cast<value_type_t>(unwrap(arg)), std::memory_order_relaxed);
+            return *this;
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::incrementable<_S>, _S>>>
+        sharded &operator++() noexcept
+        {
+            _local().fetch_add(1, std::memory_order_relaxed);
+            return *this;
+        }
+
+        template <typename _S = S, typename = std::enable_if_t<std::is_base_of_v<traits::decrementable<_S>, _S>>>
+        sharded &operator--() noexcept
+        {
+            _local().fetch_sub(1, std::memory_order_relaxed);
+            return *this;
+        }
+
+    private:
+        struct alignas(STRONG_TYPE_CACHE_LINE_SIZE) slot
+        {
+            std::atomic<value_type_t> value{value_type_t()};
+            char padding[STRONG_TYPE_CACHE_LINE_SIZE - sizeof(std::atomic<value_type_t>)];
+        };
+
+        static std::size_t _round_up(std::size_t shards) noexcept
+        {
+            std::size_t count = 1;
+
+            while (count < shards)
+                count *= 2;
+            return count;
+        }
+
+        std::atomic<value_type_t> &_local() noexcept
+        {
+            return _slots[details::this_thread_shard() & _mask].value;
+        }
+
+        std::size_t _mask;
+        std::unique_ptr<slot[]> _slots;
+    };
+}
+
+#endif /* !STRONG_TYPE_SHARDED_HPP */
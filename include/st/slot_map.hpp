@@ -0,0 +1,207 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_SLOT_MAP_HPP
+#define STRONG_TYPE_SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <st/handle.hpp>
+
+namespace st
+{
+    /**
+     * Container handing out generational handles to its values
+     *
+     * Insertion, erasure and lookup are O(1) and never hash. Values are stored contiguously and iteration only goes
+     * over live values, in no particular order: erasing a value moves the last value in its place, which invalidates
+     * iterators and references to the last value, but never handles.
+     *
+     * Looking up a handle whose value was erased fails, even if its slot has been reused since. Generations wrap around
+     * after 2^32 - 1 reuses of the same slot.
+     */
+    template <typename Tag, typename T>
+    class slot_map
+    {
+    public:
+        using handle_type = handle<Tag>;
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = typename std::vector<T>::iterator;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+        /** Constructs a value from args, the slot map being left unchanged if an exception is thrown */
+        template <typename ...Args>
+        handle_type emplace(Args &&...args)
+        {
+            const auto pos = static_cast<std::uint32_t>(_values.size());
+            const bool reuses_slot = _free_head != npos;
+            const auto idx = static_cast<std::uint32_t>(reuses_slot ? _free_head : _slots.size());
+
+            /* The bookkeeping vectors grow first, as they can be shrunk back without throwing */
+            if (!reuses_slot)
+                _slots.push_back({1, npos});
+            try {
+                _slot_of.push_back(idx);
+                _values.emplace_back(std::forward<Args>(args)...);
+            } catch (...) {
+                if (_slot_of.size() > _values.size())
+                    _slot_of.pop_back();
+                if (!reuses_slot)
+                    _slots.pop_back();
+                throw;
+            }
+            if (reuses_slot)
+                _free_head = _slots[idx].position;
+            _slots[idx].position = pos;
+            return handle_type(idx, _slots[idx].generation);
+        }
+
+        handle_type insert(const T &value)
+        {
+            return emplace(value);
+        }
+
+        handle_type insert(T &&value)
+        {
+            return emplace(std::move(value));
+        }
+
+        /** Erases the value referred to by h, returns whether there was one */
+        bool erase(const handle_type &h)
+        {
+            if (!contains(h))
+                return false;
+
+            auto &slot = _slots[h.index()];
+            const auto pos = slot.position;
+
+            if (pos != _values.size() - 1) {
+                _values[pos] = std::move(_values.back());
+                _slot_of[pos] = _slot_of.back();
+                _slots[_slot_of[pos]].position = pos;
+            }
+            _values.pop_back();
+            _slot_of.pop_back();
+            slot.generation = slot.generation == std::numeric_limits<std::uint32_t>::max() ? 1 : slot.generation + 1;
+            slot.position = static_cast<std::uint32_t>(_free_head);
+            _free_head = h.index();
+            return true;
+        }
+
+        bool contains(const handle_type &h) const noexcept
+        {
+            return h.index() < _slots.size() && _slots[h.index()].generation == h.generation();
+        }
+
+        /** Returns a pointer to the value referred to by h, or nullptr if it was erased */
+        T *get(const handle_type &h) noexcept
+        {
+            return contains(h) ? &_values[_slots[h.index()].position] : nullptr;
+        }
+
+        const T *get(const handle_type &h) const noexcept
+        {
+            return contains(h) ? &_values[_slots[h.index()].position] : nullptr;
+        }
+
+        T &at(const handle_type &h)
+        {
+            if (!contains(h))
+                throw std::out_of_range("st::slot_map::at: stale or invalid handle");
+            return _values[_slots[h.index()].position];
+        }
+
+        const T &at(const handle_type &h) const
+        {
+            if (!contains(h))
+                throw std::out_of_range("st::slot_map::at: stale or invalid handle");
+            return _values[_slots[h.index()].position];
+        }
+
+        /** Unchecked access, h must refer to a live value */
+        T &operator[](const handle_type &h) noexcept
+        {
+            return _values[_slots[h.index()].position];
+        }
+
+        const T &operator[](const handle_type &h) const noexcept
+        {
+            return _values[_slots[h.index()].position];
+        }
+
+        /** Handle of the value pointed to by it */
+        handle_type handle_of(const_iterator it) const noexcept
+        {
+            const auto idx = _slot_of[static_cast<size_type>(it - _values.begin())];
+
+            return handle_type(idx, _slots[idx].generation);
+        }
+
+        void clear()
+        {
+            while (!_values.empty())
+                erase(handle_of(_values.end() - 1));
+        }
+
+        void reserve(size_type count)
+        {
+            _values.reserve(count);
+            _slot_of.reserve(count);
+            _slots.reserve(count);
+        }
+
+        size_type size() const noexcept
+        {
+            return _values.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return _values.empty();
+        }
+
+        iterator begin() noexcept
+        {
+            return _values.begin();
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return _values.begin();
+        }
+
+        iterator end() noexcept
+        {
+            return _values.end();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return _values.end();
+        }
+
+    private:
+        static constexpr const std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+        struct slot
+        {
+            std::uint32_t generation;
+            /** Position of the value in _values when the slot is used, next free slot otherwise */
+            std::uint32_t position;
+        };
+
+        std::vector<slot> _slots;
+        std::vector<std::uint32_t> _slot_of;
+        std::vector<T> _values;
+        /** First free slot, stored as a std::size_t to avoid padding */
+        std::size_t _free_head = npos;
+    };
+}
+
+#endif /* !STRONG_TYPE_SLOT_MAP_HPP */
@@ -0,0 +1,266 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_SPAN_HPP
+#define STRONG_TYPE_SPAN_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <st/is_strong_type.hpp>
+
+namespace st
+{
+    /**
+     * Non-owning view over a contiguous sequence of objects
+     *
+     * This is a minimal equivalent of C++20's std::span with a dynamic extent.
+     */
+    template <typename T>
+    class span
+    {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+        using iterator = T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        constexpr span() noexcept = default;
+
+        constexpr span(T *data, size_type size) noexcept : _data(data), _size(size)
+        {
+        }
+
+        constexpr span(T *first, T *last) noexcept : _data(first), _size(static_cast<size_type>(last - first))
+        {
+        }
+
+        template <std::size_t N>
+        constexpr span(T (&array)[N]) noexcept : _data(array), _size(N)
+        {
+        }
+
+        template <typename Container, typename = std::enable_if_t<
+            !std::is_base_of_v<span, std::remove_cv_t<Container>> &&
+            std::is_convertible_v<std::remove_pointer_t<decltype(std::data(std::declval<Container &>()))> (*)[],
+                                  T (*)[]>
+        >>
+        constexpr span(Container &c) noexcept : _data(std::data(c)), _size(std::size(c))
+        {
+        }
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+        constexpr span(const span<U> &other) noexcept : _data(other.data()), _size(other.size())
+        {
+        }
+
+        constexpr T *data() const noexcept
+        {
+            return _data;
+        }
+
+        constexpr size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        constexpr size_type size_bytes() const noexcept
+        {
+            return _size * sizeof(T);
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        constexpr T &operator[](size_type idx) const noexcept
+        {
+            return _data[idx];
+        }
+
+        constexpr T &front() const noexcept
+        {
+            return _data[0];
+        }
+
+        constexpr T &back() const noexcept
+        {
+            return _data[_size - 1];
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return _data;
+        }
+
+        constexpr iterator end() const noexcept
+        {
+            return _data + _size;
+        }
+
+        constexpr reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        constexpr reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        constexpr span first(size_type count) const noexcept
+        {
+            return span(_data, count);
+        }
+
+        constexpr span last(size_type count) const noexcept
+        {
+            return span(_data + (_size - count), count);
+        }
+
+        constexpr span subspan(size_type offset, size_type count = static_cast<size_type>(-1)) const noexcept
+        {
+            return span(_data + offset, count == static_cast<size_type>(-1) ? _size - offset : count);
+        }
+
+    private:
+        T *_data{nullptr};
+        size_type _size{0};
+    };
+
+    template <typename T, std::size_t N>
+    span(T (&)[N]) -> span<T>;
+
+    template <typename Container>
+    span(Container &) -> span<std::remove_pointer_t<decltype(std::data(std::declval<Container &>()))>>;
+
+    namespace details
+    {
+        template <typename T, bool = is_strong_type_v<T>>
+        struct is_layout_compatible_helper : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_layout_compatible_helper<T, true> : std::bool_constant<
+            sizeof(T) == sizeof(typename T::value_type) &&
+            alignof(T) == alignof(typename T::value_type) &&
+            std::is_standard_layout_v<T> &&
+            std::is_standard_layout_v<typename T::value_type>
+        >
+        {
+        };
+
+        template <typename T, bool = is_strong_type_v<T>>
+        struct span_underlying
+        {
+            using type = T;
+        };
+
+        template <typename T>
+        struct span_underlying<T, true>
+        {
+            using type = typename T::value_type;
+        };
+
+        template <typename T>
+        using span_underlying_t = std::remove_cv_t<typename span_underlying<std::remove_cv_t<T>>::type>;
+
+        template <typename T>
+        struct is_span : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_span<span<T>> : std::true_type
+        {
+        };
+
+        template <typename Container>
+        using container_element_t = std::remove_pointer_t<decltype(std::data(std::declval<Container &>()))>;
+
+        template <typename To, typename From>
+        using copy_const_t = std::conditional_t<std::is_const_v<From>, const To, To>;
+    }
+
+    /**
+     * Whether a strong type can be used in place of its underlying type in memory
+     *
+     * Buffers of such strong types can be reinterpreted as buffers of their underlying type, and vice versa.
+     */
+    template <typename T>
+    struct is_layout_compatible : details::is_layout_compatible_helper<std::remove_cv_t<T>>
+    {
+    };
+
+    template <typename T>
+    inline constexpr const bool is_layout_compatible_v = is_layout_compatible<T>::value;
+
+    /**
+     * Whether a span<From> can be viewed as a span<To>
+     *
+     * One of the two types must be a layout-compatible strong type, and the other one its underlying type.
+     * Constness can be added, but not removed.
+     */
+    template <typename From, typename To>
+    inline constexpr const bool is_span_castable_v =
+        (std::is_const_v<To> || !std::is_const_v<From>) &&
+        !std::is_volatile_v<From> && !std::is_volatile_v<To> &&
+        std::is_same_v<details::span_underlying_t<From>, details::span_underlying_t<To>> &&
+        ((is_layout_compatible_v<From> && !is_strong_type_v<std::remove_cv_t<To>>) ||
+         (is_layout_compatible_v<To> && !is_strong_type_v<std::remove_cv_t<From>>) ||
+         std::is_same_v<std::remove_cv_t<From>, std::remove_cv_t<To>>);
+
+    /** View a buffer of strong types as a buffer of their underlying type (or the other way around), without copying */
+    template <typename To, typename From, typename = std::enable_if_t<is_span_castable_v<From, To>>>
+    inline span<To> span_cast(span<From> s) noexcept
+    {
+        return span<To>(reinterpret_cast<To *>(s.data()), s.size());
+    }
+
+    template <typename Strong, typename T, typename = std::enable_if_t<
+        is_span_castable_v<T, details::copy_const_t<Strong, T>>
+    >>
+    inline span<details::copy_const_t<Strong, T>> as_strong_span(span<T> s) noexcept
+    {
+        return span_cast<details::copy_const_t<Strong, T>>(s);
+    }
+
+    template <typename Strong, typename T, typename = std::enable_if_t<
+        is_span_castable_v<T, details::copy_const_t<Strong, T>>
+    >>
+    inline span<details::copy_const_t<Strong, T>> as_strong_span(T *data, std::size_t size) noexcept
+    {
+        return as_strong_span<Strong>(span<T>(data, size));
+    }
+
+    template <typename Strong, typename Container,
+        typename = std::enable_if_t<!details::is_span<std::remove_cv_t<Container>>::value>>
+    inline auto as_strong_span(Container &c) noexcept -> decltype(as_strong_span<Strong>(std::data(c), std::size(c)))
+    {
+        return as_strong_span<Strong>(std::data(c), std::size(c));
+    }
+
+    template <typename Strong, typename = std::enable_if_t<is_layout_compatible_v<Strong>>>
+    inline span<details::copy_const_t<typename std::remove_cv_t<Strong>::value_type, Strong>>
+    as_raw_span(span<Strong> s) noexcept
+    {
+        return span_cast<details::copy_const_t<typename std::remove_cv_t<Strong>::value_type, Strong>>(s);
+    }
+
+    template <typename Container,
+        typename = std::enable_if_t<!details::is_span<std::remove_cv_t<Container>>::value>>
+    inline auto as_raw_span(Container &c) noexcept
+    -> decltype(as_raw_span(span<details::container_element_t<Container>>(c)))
+    {
+        return as_raw_span(span<details::container_element_t<Container>>(c));
+    }
+}
+
+#endif /* !STRONG_TYPE_SPAN_HPP */
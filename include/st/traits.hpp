@@ -5,9 +5,11 @@
 #ifndef STRONG_TYPE_TRAITS_HPP
 #define STRONG_TYPE_TRAITS_HPP
 
+#include <atomic>
 #include <type_traits>
 #include <functional>
 #include <st/unwrap.hpp>
+#include <st/hash_policies.hpp>
 
 namespace st
 {
@@ -27,6 +29,38 @@ namespace st
             {
                 return ReturnT(unwrap(lhs) + rhs.value());
             }
+
+            friend constexpr ReturnT operator+(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() + unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator+(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() + unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator+(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() + unwrap(std::move(rhs)));
+            }
+
+            template <typename _T = T, typename _Other = OtherOperandT,
+                typename = std::enable_if_t<!std::is_same_v<_T, _Other>>>
+            friend constexpr ReturnT operator+(const OtherOperandT &lhs, T &&rhs) noexcept
+            {
+                return ReturnT(unwrap(lhs) + std::move(rhs).value());
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct add_assignable
+        {
+            friend constexpr T &operator+=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() += unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T, typename OtherOperandT = T, typename ReturnT = T>
@@ -36,6 +70,31 @@ namespace st
             {
                 return ReturnT(lhs.value() - unwrap(rhs));
             }
+
+            friend constexpr ReturnT operator-(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() - unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator-(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() - unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator-(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() - unwrap(std::move(rhs)));
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct subtract_assignable
+        {
+            friend constexpr T &operator-=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() -= unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T, typename OtherOperandT = T, typename ReturnT = T>
@@ -52,6 +111,38 @@ namespace st
             {
                 return ReturnT(unwrap(other) * lhs.value());
             }
+
+            friend constexpr ReturnT operator*(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() * unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator*(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() * unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator*(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() * unwrap(std::move(rhs)));
+            }
+
+            template <typename _T = T, typename _Other = OtherOperandT,
+                typename = std::enable_if_t<!std::is_same_v<_T, _Other>>>
+            friend constexpr ReturnT operator*(const OtherOperandT &lhs, T &&rhs) noexcept
+            {
+                return ReturnT(unwrap(lhs) * std::move(rhs).value());
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct multiply_assignable
+        {
+            friend constexpr T &operator*=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() *= unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T, typename OtherOperandT = T, typename ReturnT = T>
@@ -61,6 +152,31 @@ namespace st
             {
                 return ReturnT(lhs.value() / unwrap(rhs));
             }
+
+            friend constexpr ReturnT operator/(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() / unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator/(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() / unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator/(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() / unwrap(std::move(rhs)));
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct divide_assignable
+        {
+            friend constexpr T &operator/=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() /= unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T, typename OtherOperandT = T, typename ReturnT = T>
@@ -70,6 +186,31 @@ namespace st
             {
                 return ReturnT(lhs.value() % unwrap(rhs));
             }
+
+            friend constexpr ReturnT operator%(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() % unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator%(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() % unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator%(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() % unwrap(std::move(rhs)));
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct modulo_assignable
+        {
+            friend constexpr T &operator%=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() %= unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T>
@@ -194,6 +335,11 @@ namespace st
                             multiplicable<T>,
                             dividable<T>,
                             modulable<T>,
+                            add_assignable<T>,
+                            subtract_assignable<T>,
+                            multiply_assignable<T>,
+                            divide_assignable<T>,
+                            modulo_assignable<T>,
                             incrementable<T>,
                             decrementable<T>,
                             equality_comparable<T>,
@@ -215,6 +361,38 @@ namespace st
             {
                 return ReturnT(unwrap(lhs) | rhs.value());
             }
+
+            friend constexpr ReturnT operator|(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() | unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator|(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() | unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator|(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() | unwrap(std::move(rhs)));
+            }
+
+            template <typename _T = T, typename _Other = OtherOperandT,
+                typename = std::enable_if_t<!std::is_same_v<_T, _Other>>>
+            friend constexpr ReturnT operator|(const OtherOperandT &lhs, T &&rhs) noexcept
+            {
+                return ReturnT(unwrap(lhs) | std::move(rhs).value());
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct bitwise_or_assignable
+        {
+            friend constexpr T &operator|=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() |= unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T, typename OtherOperandT = T, typename ReturnT = T>
@@ -231,6 +409,38 @@ namespace st
             {
                 return ReturnT(unwrap(lhs) & rhs.value());
             }
+
+            friend constexpr ReturnT operator&(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() & unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator&(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() & unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator&(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() & unwrap(std::move(rhs)));
+            }
+
+            template <typename _T = T, typename _Other = OtherOperandT,
+                typename = std::enable_if_t<!std::is_same_v<_T, _Other>>>
+            friend constexpr ReturnT operator&(const OtherOperandT &lhs, T &&rhs) noexcept
+            {
+                return ReturnT(unwrap(lhs) & std::move(rhs).value());
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct bitwise_and_assignable
+        {
+            friend constexpr T &operator&=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() &= unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T, typename OtherOperandT = T, typename ReturnT = T>
@@ -247,6 +457,38 @@ namespace st
             {
                 return ReturnT(unwrap(lhs) ^ rhs.value());
             }
+
+            friend constexpr ReturnT operator^(T &&lhs, const OtherOperandT &rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() ^ unwrap(rhs));
+            }
+
+            friend constexpr ReturnT operator^(const T &lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(lhs.value() ^ unwrap(std::move(rhs)));
+            }
+
+            friend constexpr ReturnT operator^(T &&lhs, OtherOperandT &&rhs) noexcept
+            {
+                return ReturnT(std::move(lhs).value() ^ unwrap(std::move(rhs)));
+            }
+
+            template <typename _T = T, typename _Other = OtherOperandT,
+                typename = std::enable_if_t<!std::is_same_v<_T, _Other>>>
+            friend constexpr ReturnT operator^(const OtherOperandT &lhs, T &&rhs) noexcept
+            {
+                return ReturnT(unwrap(lhs) ^ std::move(rhs).value());
+            }
+        };
+
+        template <typename T, typename OtherOperandT = T>
+        struct bitwise_xor_assignable
+        {
+            friend constexpr T &operator^=(T &lhs, const OtherOperandT &rhs) noexcept
+            {
+                lhs.value() ^= unwrap(rhs);
+                return lhs;
+            }
         };
 
         template <typename T, typename ReturnT = T>
@@ -256,18 +498,42 @@ namespace st
             {
                 return ReturnT(~lhs.value());
             }
+
+            friend constexpr ReturnT operator~(T &&lhs) noexcept
+            {
+                return ReturnT(~std::move(lhs).value());
+            }
         };
 
         template <typename T>
         struct bitwise_manipulable : bitwise_orable<T>,
                                      bitwise_andable<T>,
                                      bitwise_xorable<T>,
-                                     bitwise_negatable<T>
+                                     bitwise_negatable<T>,
+                                     bitwise_or_assignable<T>,
+                                     bitwise_and_assignable<T>,
+                                     bitwise_xor_assignable<T>
         {
         };
 
-        template <typename T>
+        template <typename T, typename HashPolicyT = hash_policies::standard>
         struct hashable
+        {
+            using hash_policy = HashPolicyT;
+        };
+
+        template <typename T, typename KeyT>
+        struct lookupable_with
+        {
+        };
+
+        template <typename T>
+        struct indexable
+        {
+        };
+
+        template <typename T>
+        struct trivially_relocatable
         {
         };
     }
@@ -285,6 +551,19 @@ namespace st
         using type = traits::addable<T, OtherOperandT>;
     };
 
+    struct add_assignable
+    {
+        template <typename T>
+        using type = traits::add_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct add_assignable_with
+    {
+        template <typename T>
+        using type = traits::add_assignable<T, OtherOperandT>;
+    };
+
     struct subtractable
     {
         template <typename T>
@@ -298,6 +577,19 @@ namespace st
         using type = traits::subtractable<T, T, ReturnT>;
     };
 
+    struct subtract_assignable
+    {
+        template <typename T>
+        using type = traits::subtract_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct subtract_assignable_with
+    {
+        template <typename T>
+        using type = traits::subtract_assignable<T, OtherOperandT>;
+    };
+
     struct multiplicable
     {
         template <typename T>
@@ -311,6 +603,19 @@ namespace st
         using type = traits::multiplicable<T, OtherOperandT>;
     };
 
+    struct multiply_assignable
+    {
+        template <typename T>
+        using type = traits::multiply_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct multiply_assignable_with
+    {
+        template <typename T>
+        using type = traits::multiply_assignable<T, OtherOperandT>;
+    };
+
     struct dividable
     {
         template <typename T>
@@ -331,12 +636,38 @@ namespace st
         using type = traits::dividable<T, T, ReturnT>;
     };
 
+    struct divide_assignable
+    {
+        template <typename T>
+        using type = traits::divide_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct divide_assignable_by
+    {
+        template <typename T>
+        using type = traits::divide_assignable<T, OtherOperandT>;
+    };
+
     struct modulable
     {
         template <typename T>
         using type = traits::modulable<T>;
     };
 
+    struct modulo_assignable
+    {
+        template <typename T>
+        using type = traits::modulo_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct modulo_assignable_by
+    {
+        template <typename T>
+        using type = traits::modulo_assignable<T, OtherOperandT>;
+    };
+
     struct incrementable
     {
         template <typename T>
@@ -361,10 +692,23 @@ namespace st
         using type = traits::orderable<T>;
     };
 
-    struct arithmetic
+    struct arithmetic : trait_bundle<
+        addable,
+        subtractable,
+        multiplicable,
+        dividable,
+        modulable,
+        add_assignable,
+        subtract_assignable,
+        multiply_assignable,
+        divide_assignable,
+        modulo_assignable,
+        incrementable,
+        decrementable,
+        equality_comparable,
+        orderable
+    >
     {
-        template <typename T>
-        using type = traits::arithmetic<T>;
     };
 
     struct bitwise_orable
@@ -380,6 +724,19 @@ namespace st
         using type = traits::bitwise_orable<T, OtherOperandT>;
     };
 
+    struct bitwise_or_assignable
+    {
+        template <typename T>
+        using type = traits::bitwise_or_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct bitwise_or_assignable_with
+    {
+        template <typename T>
+        using type = traits::bitwise_or_assignable<T, OtherOperandT>;
+    };
+
     struct bitwise_andable
     {
         template <typename T>
@@ -393,6 +750,19 @@ namespace st
         using type = traits::bitwise_andable<T, OtherOperandT>;
     };
 
+    struct bitwise_and_assignable
+    {
+        template <typename T>
+        using type = traits::bitwise_and_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct bitwise_and_assignable_with
+    {
+        template <typename T>
+        using type = traits::bitwise_and_assignable<T, OtherOperandT>;
+    };
+
     struct bitwise_xorable
     {
         template <typename T>
@@ -406,16 +776,35 @@ namespace st
         using type = traits::bitwise_xorable<T, OtherOperandT>;
     };
 
+    struct bitwise_xor_assignable
+    {
+        template <typename T>
+        using type = traits::bitwise_xor_assignable<T>;
+    };
+
+    template <typename OtherOperandT>
+    struct bitwise_xor_assignable_with
+    {
+        template <typename T>
+        using type = traits::bitwise_xor_assignable<T, OtherOperandT>;
+    };
+
     struct bitwise_negatable
     {
         template <typename T>
         using type = traits::bitwise_negatable<T>;
     };
 
-    struct bitwise_manipulable
+    struct bitwise_manipulable : trait_bundle<
+        bitwise_orable,
+        bitwise_andable,
+        bitwise_xorable,
+        bitwise_negatable,
+        bitwise_or_assignable,
+        bitwise_and_assignable,
+        bitwise_xor_assignable
+    >
     {
-        template <typename T>
-        using type = traits::bitwise_manipulable<T>;
     };
 
     struct hashable
@@ -423,12 +812,216 @@ namespace st
         template <typename T>
         using type = traits::hashable<T>;
     };
+
+    template <typename HashPolicyT>
+    struct hashable_with
+    {
+        template <typename T>
+        using type = traits::hashable<T, HashPolicyT>;
+    };
+
+    /**
+     * Storage caching the hash of the wrapped value, used by the hash_cached traits
+     *
+     * The hash is computed on construction, and recomputed lazily once the value has been accessed through a mutable
+     * value() overload. A cached hash of 0 means that the hash must be recomputed, which avoids storing a flag (a value
+     * whose hash is 0 is simply hashed every time). Moving from a hash_cached_storage invalidates the hash of the source.
+     */
+    template <typename T, typename HashPolicyT>
+    class hash_cached_storage : public type_base<T>
+    {
+        using base_type = type_base<T>;
+
+        static constexpr bool is_nothrow_hashable_v = noexcept(HashPolicyT()(std::declval<const T &>()));
+
+    public:
+        hash_cached_storage() noexcept(std::is_nothrow_default_constructible_v<T> && is_nothrow_hashable_v) :
+            base_type(), _hash(_compute())
+        {
+        }
+
+        template <typename ...Args, typename = std::enable_if_t<
+            details::is_forwarding_constructor<hash_cached_storage, base_type, Args...>::value
+        >>
+        explicit hash_cached_storage(Args &&...args) noexcept(
+            std::is_nothrow_constructible_v<base_type, Args &&...> && is_nothrow_hashable_v) :
+            base_type(std::forward<Args>(args)...), _hash(_compute())
+        {
+        }
+
+        hash_cached_storage(const hash_cached_storage &other) : base_type(other), _hash(other._load())
+        {
+        }
+
+        hash_cached_storage(hash_cached_storage &&other) noexcept(std::is_nothrow_move_constructible_v<T>) :
+            base_type(std::move(other)), _hash(other._hash.exchange(0, std::memory_order_relaxed))
+        {
+        }
+
+        /*
+         * Allocator-extended copies and moves, which the forwarding constructor rejects since their argument is a
+         * strong type: the copy holds an equal value, so that the cached hash carries over
+         */
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, const T &>
+        >>
+        hash_cached_storage(std::allocator_arg_t, const AllocatorT &alloc, const hash_cached_storage &other) :
+            base_type(std::allocator_arg, alloc, other), _hash(other._load())
+        {
+        }
+
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, T &&>
+        >>
+        hash_cached_storage(std::allocator_arg_t, const AllocatorT &alloc, hash_cached_storage &&other) :
+            base_type(std::allocator_arg, alloc, std::move(other)),
+            _hash(other._hash.exchange(0, std::memory_order_relaxed))
+        {
+        }
+
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, const T &>
+        >>
+        hash_cached_storage(const hash_cached_storage &other, const AllocatorT &alloc) :
+            base_type(other, alloc), _hash(other._load())
+        {
+        }
+
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, T &&>
+        >>
+        hash_cached_storage(hash_cached_storage &&other, const AllocatorT &alloc) :
+            base_type(std::move(other), alloc), _hash(other._hash.exchange(0, std::memory_order_relaxed))
+        {
+        }
+
+        hash_cached_storage &operator=(const hash_cached_storage &other)
+        {
+            base_type::operator=(other);
+            _hash.store(other._load(), std::memory_order_relaxed);
+            return *this;
+        }
+
+        hash_cached_storage &operator=(hash_cached_storage &&other) noexcept(std::is_nothrow_move_assignable_v<T>)
+        {
+            base_type::operator=(std::move(other));
+            _hash.store(other._hash.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        const T &value() const & noexcept
+        {
+            return base_type::value();
+        }
+
+        T &value() & noexcept
+        {
+            _hash.store(0, std::memory_order_relaxed);
+            return base_type::value();
+        }
+
+        const T &&value() const && noexcept
+        {
+            return std::move(base_type::value());
+        }
+
+        T &&value() && noexcept
+        {
+            _hash.store(0, std::memory_order_relaxed);
+            return std::move(base_type::value());
+        }
+
+        std::size_t cached_hash() const noexcept(is_nothrow_hashable_v)
+        {
+            auto h = _load();
+
+            if (h == 0) {
+                h = _compute();
+                _hash.store(h, std::memory_order_relaxed);
+            }
+            return h;
+        }
+
+    private:
+        std::size_t _compute() const noexcept(is_nothrow_hashable_v)
+        {
+            return HashPolicyT()(base_type::value());
+        }
+
+        std::size_t _load() const noexcept
+        {
+            return _hash.load(std::memory_order_relaxed);
+        }
+
+        mutable std::atomic<std::size_t> _hash;
+    };
+
+    template <typename HashPolicyT>
+    struct hash_cached_with
+    {
+        template <typename T>
+        using type = traits::hashable<T, HashPolicyT>;
+
+        template <typename T>
+        using storage = hash_cached_storage<T, HashPolicyT>;
+    };
+
+    struct hash_cached : hash_cached_with<hash_policies::standard>
+    {
+    };
+
+    template <typename KeyT>
+    struct lookupable_with
+    {
+        template <typename T>
+        using type = traits::lookupable_with<T, KeyT>;
+    };
+
+    struct indexable
+    {
+        template <typename T>
+        using type = traits::indexable<T>;
+    };
+
+    struct trivially_relocatable
+    {
+        template <typename T>
+        using type = traits::trivially_relocatable<T>;
+    };
 }
 
 namespace st::details
 {
     template <typename T, typename>
     using fst = T;
+
+    template <typename T, typename HashPolicyT>
+    HashPolicyT hash_policy_of(const traits::hashable<T, HashPolicyT> &);
+
+    /** The hash policy of the strong type T, deduced from its hashable base */
+    template <typename T>
+    using hash_policy_t = decltype(hash_policy_of<T>(std::declval<const T &>()));
+
+    template <typename T, typename = void>
+    struct has_cached_hash : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct has_cached_hash<T, std::void_t<decltype(std::declval<const T &>().cached_hash())>> : std::true_type
+    {
+    };
+
+    /**
+     * Whether T hashes in O(1) without throwing
+     *
+     * std::hash of such types is noexcept, which lets standard containers skip storing hash codes in their nodes.
+     */
+    template <typename T, bool = has_cached_hash<T>::value>
+    inline constexpr bool is_nothrow_cached_hash_v = false;
+
+    template <typename T>
+    inline constexpr bool is_nothrow_cached_hash_v<T, true> = noexcept(std::declval<const T &>().cached_hash());
 }
 
 namespace std
@@ -436,12 +1029,16 @@ namespace std
     template <typename T, typename ...Ts>
     struct hash<st::details::fst<
         st::type<T, Ts...>,
-        std::enable_if_t<std::is_base_of_v<st::traits::hashable<st::type<T, Ts...>>, st::type<T, Ts...>>>
+        st::details::hash_policy_t<st::type<T, Ts...>>
     >>
     {
         auto operator()(const st::type<T, Ts...> &t) const
+            noexcept(st::details::is_nothrow_cached_hash_v<st::type<T, Ts...>>)
         {
-            return std::hash<T>()(t.value());
+            if constexpr (st::details::has_cached_hash<st::type<T, Ts...>>::value)
+                return t.cached_hash();
+            else
+                return st::details::hash_policy_t<st::type<T, Ts...>>()(t.value());
         }
     };
 }
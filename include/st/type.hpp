@@ -5,20 +5,67 @@
 #ifndef STRONG_TYPE_TYPE_HPP
 #define STRONG_TYPE_TYPE_HPP
 
+#include <memory>
 #include <utility>
 #include <type_traits>
 
+#if defined(_MSC_VER)
+/** MSVC only applies the empty base optimization to the first base class unless asked to */
+#define STRONG_TYPE_EMPTY_BASES __declspec(empty_bases)
+#else
+#define STRONG_TYPE_EMPTY_BASES
+#endif
+
 namespace st
 {
+    namespace details
+    {
+        template <typename T, typename = void>
+        struct allocator_type_base
+        {
+        };
+
+        /** Exposes the allocator type of T, so that strong types wrapping T also satisfy std::uses_allocator */
+        template <typename T>
+        struct allocator_type_base<T, std::void_t<typename T::allocator_type>>
+        {
+            using allocator_type = typename T::allocator_type;
+        };
+
+        template <typename T, typename AllocatorT, typename ...Args>
+        inline constexpr bool is_constructible_using_allocator_v =
+            std::uses_allocator_v<T, AllocatorT> &&
+            (std::is_constructible_v<T, std::allocator_arg_t, const AllocatorT &, Args...> ||
+             std::is_constructible_v<T, Args..., const AllocatorT &>);
+
+        /** Uses-allocator construction of a T, following the leading or trailing allocator convention of T */
+        template <typename T, typename AllocatorT, typename ...Args>
+        constexpr T make_using_allocator(const AllocatorT &alloc, Args &&...args)
+        {
+            if constexpr (std::is_constructible_v<T, std::allocator_arg_t, const AllocatorT &, Args...>)
+                return T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+            else
+                return T(std::forward<Args>(args)..., alloc);
+        }
+    }
+
+    /**
+     * Base of all strong types, holding the wrapped value
+     *
+     * When T is allocator-aware, type_base exposes T's allocator_type and provides allocator-extended constructors
+     * (using the std::allocator_arg_t convention), so that containers propagate their allocator to wrapped values.
+     */
     template <typename T>
-    class type_base
+    class type_base : public details::allocator_type_base<T>
     {
     public:
-        explicit constexpr type_base() : _t()
+        using value_type = T;
+
+        explicit constexpr type_base() noexcept(std::is_nothrow_default_constructible_v<T>) : _t()
         {
         }
 
-        explicit constexpr type_base(const T &t) : _t(t)
+        explicit constexpr type_base(const T &t) noexcept(std::is_nothrow_copy_constructible_v<T>) : _t(t)
         {
         }
 
@@ -26,6 +73,54 @@ namespace st
         {
         }
 
+        /** Constructs the wrapped value in place from args, without any temporary T */
+        template <typename ...Args, typename = std::enable_if_t<std::is_constructible_v<T, Args &&...>>>
+        explicit constexpr type_base(std::in_place_t, Args &&...args) noexcept(
+            std::is_nothrow_constructible_v<T, Args &&...>) :
+            _t(std::forward<Args>(args)...)
+        {
+        }
+
+        template <typename AllocatorT, typename ...Args, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, Args &&...>
+        >>
+        constexpr type_base(std::allocator_arg_t, const AllocatorT &alloc, Args &&...args) :
+            _t(details::make_using_allocator<T>(alloc, std::forward<Args>(args)...))
+        {
+        }
+
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, const T &>
+        >>
+        constexpr type_base(std::allocator_arg_t, const AllocatorT &alloc, const type_base &other) :
+            _t(details::make_using_allocator<T>(alloc, other._t))
+        {
+        }
+
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, T &&>
+        >>
+        constexpr type_base(std::allocator_arg_t, const AllocatorT &alloc, type_base &&other) :
+            _t(details::make_using_allocator<T>(alloc, std::move(other._t)))
+        {
+        }
+
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, const T &>
+        >>
+        constexpr type_base(const type_base &other, const AllocatorT &alloc) :
+            _t(details::make_using_allocator<T>(alloc, other._t))
+        {
+        }
+
+        template <typename AllocatorT, typename = std::enable_if_t<
+            details::is_constructible_using_allocator_v<T, AllocatorT, T &&>
+        >>
+        constexpr type_base(type_base &&other, const AllocatorT &alloc) :
+            _t(details::make_using_allocator<T>(alloc, std::move(other._t)))
+        {
+        }
+
         constexpr type_base(const type_base &) = default;
 
         constexpr type_base(type_base &&) noexcept(std::is_nothrow_move_constructible_v<T>) = default;
@@ -58,17 +153,200 @@ namespace st
         T _t;
     };
 
+    namespace details
+    {
+        template <typename ...Ts>
+        struct type_list
+        {
+        };
+
+        template <typename List, typename T>
+        struct append_unique;
+
+        template <typename ...Ts, typename T>
+        struct append_unique<type_list<Ts...>, T>
+        {
+            using type = std::conditional_t<(std::is_same_v<Ts, T> || ...), type_list<Ts...>, type_list<Ts..., T>>;
+        };
+
+        template <typename Self, typename Bases, typename ...Traits>
+        struct collect_trait_bases
+        {
+            using type = Bases;
+        };
+
+        template <typename Self, typename Bases, typename Trait, typename = void>
+        struct collect_trait
+        {
+            using type = typename append_unique<Bases, typename Trait::template type<Self>>::type;
+        };
+
+        template <typename Self, typename Bases, typename TraitList>
+        struct collect_trait_list;
+
+        template <typename Self, typename Bases, typename ...Traits>
+        struct collect_trait_list<Self, Bases, type_list<Traits...>>
+        {
+            using type = typename collect_trait_bases<Self, Bases, Traits...>::type;
+        };
+
+        template <typename Self, typename Bases, typename Trait>
+        struct collect_trait<Self, Bases, Trait, std::void_t<typename Trait::bundled_traits>>
+        {
+            using type = typename collect_trait_list<Self, Bases, typename Trait::bundled_traits>::type;
+        };
+
+        template <typename Self, typename Bases, typename Trait, typename ...Traits>
+        struct collect_trait_bases<Self, Bases, Trait, Traits...>
+        {
+            using type = typename collect_trait_bases<
+                Self,
+                typename collect_trait<Self, Bases, Trait>::type,
+                Traits...
+            >::type;
+        };
+
+        template <typename Bases>
+        struct STRONG_TYPE_EMPTY_BASES inherit_all;
+
+        template <typename ...Bases>
+        struct STRONG_TYPE_EMPTY_BASES inherit_all<type_list<Bases...>> : Bases ...
+        {
+        };
+
+        /** Flattened and deduplicated set of trait classes to be inherited by the strong type Self */
+        template <typename Self, typename ...Traits>
+        using trait_bases_t = inherit_all<typename collect_trait_bases<Self, type_list<>, Traits...>::type>;
+
+        template <typename Self, typename Base, typename Arg>
+        inline constexpr bool is_other_strong_type_v =
+            std::is_base_of_v<Base, std::decay_t<Arg>> && !std::is_same_v<std::decay_t<Arg>, Self>;
+
+        template <typename Trait, typename T, typename = void>
+        struct trait_storage
+        {
+            using type = void;
+        };
+
+        template <typename Trait, typename T>
+        struct trait_storage<Trait, T, std::void_t<typename Trait::template storage<T>>>
+        {
+            using type = typename Trait::template storage<T>;
+        };
+
+        /** Storage of a strong type: the one provided by a trait declaring a storage template, or type_base<T> */
+        template <typename T, typename ...Traits>
+        struct select_storage
+        {
+            using type = type_base<T>;
+        };
+
+        template <typename T, typename Trait, typename ...Traits>
+        struct select_storage<T, Trait, Traits...>
+        {
+            using trait_type = typename trait_storage<Trait, T>::type;
+            using next_type = typename select_storage<T, Traits...>::type;
+
+            static_assert(std::is_void_v<trait_type> || std::is_same_v<next_type, type_base<T>>,
+                          "a strong type can only have a single storage policy");
+
+            using type = std::conditional_t<std::is_void_v<trait_type>, next_type, trait_type>;
+        };
+
+        template <typename T, typename ...Traits>
+        using storage_t = typename select_storage<T, Traits...>::type;
+
+        /** Whether Args may be forwarded to the base of Self without hijacking copies or slicing other strong types */
+        template <typename Self, typename Base, typename ...Args>
+        struct is_forwarding_constructor : std::false_type
+        {
+        };
+
+        template <typename Self, typename Base, typename Arg, typename ...Args>
+        struct is_forwarding_constructor<Self, Base, Arg, Args...> : std::bool_constant<
+            !(sizeof...(Args) == 0 && std::is_same_v<std::decay_t<Arg>, Self>) &&
+            !is_other_strong_type_v<Self, Base, Arg> &&
+            (!is_other_strong_type_v<Self, Base, Args> && ...) &&
+            std::is_constructible_v<Base, Arg &&, Args &&...>
+        >
+        {
+        };
+    }
+
+    /**
+     * Groups several traits under a single name
+     *
+     * The bundled traits are flattened into the strong type using the bundle, so that traits appearing both in
+     * a bundle and on their own are only inherited once.
+     */
+    template <typename ...Traits>
+    struct trait_bundle
+    {
+        using bundled_traits = details::type_list<Traits...>;
+
+        template <typename T>
+        using type = details::trait_bases_t<T, Traits...>;
+    };
+
+    /**
+     * Strong type wrapping a T, distinguished by Tag and given additional behavior by Traits
+     *
+     * The wrapped value is stored in type_base<T>, unless a trait provides another storage through a nested
+     * template <typename T> using storage = ...; alias. Such a storage must derive from type_base<T>, and is
+     * accessed through the same value() member functions.
+     */
     template <typename T, typename Tag, typename ...Traits>
-    class type :
-        public Traits::template type<type<T, Tag, Traits...>> ...,
-        public type_base<T>
+    class STRONG_TYPE_EMPTY_BASES type :
+        public details::trait_bases_t<type<T, Tag, Traits...>, Traits...>,
+        public details::storage_t<T, Traits...>
     {
+        using base_type = details::storage_t<T, Traits...>;
+
+        /** The default storage must be laid out exactly as T, custom storages as themselves */
+        using layout_type = std::conditional_t<std::is_same_v<base_type, type_base<T>>, T, base_type>;
+
+        static_assert(std::is_empty_v<details::trait_bases_t<type, Traits...>>,
+                      "traits of a strong type must not have data members");
+        static_assert(std::is_base_of_v<type_base<T>, base_type>,
+                      "the storage of a strong type must derive from type_base");
+
+        static constexpr void check_layout() noexcept
+        {
+            static_assert(sizeof(type) == sizeof(layout_type),
+                          "strong type must have the same size as its underlying type");
+            static_assert(alignof(type) == alignof(layout_type),
+                          "strong type must have the same alignment as its underlying type");
+            static_assert(std::is_standard_layout_v<type> == std::is_standard_layout_v<layout_type>,
+                          "strong type must be standard-layout if and only if its underlying type is");
+            static_assert(std::is_trivially_copyable_v<type> == std::is_trivially_copyable_v<layout_type>,
+                          "strong type must be trivially copyable if and only if its underlying type is");
+        }
+
     public:
-        using type_base<T>::type_base;
+        template <typename _T = T, typename = std::enable_if_t<std::is_default_constructible_v<_T>>>
+        constexpr type() noexcept(std::is_nothrow_default_constructible_v<_T>) : base_type()
+        {
+            check_layout();
+        }
+
+        template <typename ...Args,
+            typename = std::enable_if_t<details::is_forwarding_constructor<type, base_type, Args...>::value>>
+        explicit constexpr type(Args &&...args) noexcept(std::is_nothrow_constructible_v<base_type, Args &&...>) :
+            base_type(std::forward<Args>(args)...)
+        {
+            check_layout();
+        }
 
         using value_type = T;
         using tag_type = Tag;
     };
+
+    /** Constructs a strong type S whose value is built in place from args */
+    template <typename S, typename ...Args>
+    constexpr S make(Args &&...args) noexcept(std::is_nothrow_constructible_v<S, std::in_place_t, Args &&...>)
+    {
+        return S(std::in_place, std::forward<Args>(args)...);
+    }
 }
 
 #endif /* !STRONG_TYPE_TYPE_HPP */
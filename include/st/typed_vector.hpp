@@ -0,0 +1,263 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_TYPED_VECTOR_HPP
+#define STRONG_TYPE_TYPED_VECTOR_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <st/traits.hpp>
+
+namespace st
+{
+    /** Whether T is a strong type wrapping an integral value and declared indexable */
+    template <typename T, bool = is_strong_type_v<T>>
+    struct is_indexable : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_indexable<T, true> : std::bool_constant<
+        std::is_base_of_v<traits::indexable<T>, T> &&
+        std::is_integral_v<typename T::value_type> &&
+        !std::is_same_v<typename T::value_type, bool>
+    >
+    {
+    };
+
+    template <typename T>
+    inline constexpr const bool is_indexable_v = is_indexable<T>::value;
+
+    namespace details
+    {
+        /** Position of an index, negative indices being converted to positions past any container */
+        template <typename IndexT>
+        constexpr std::size_t to_position(const IndexT &idx) noexcept
+        {
+            return static_cast<std::size_t>(idx.value());
+        }
+
+        template <typename IndexT>
+        constexpr IndexT from_position(std::size_t pos) noexcept
+        {
+            return IndexT(static_cast<typename IndexT::value_type>(pos));
+        }
+    }
+
+    /**
+     * Contiguous sequence of values which can only be accessed through a given strong index type
+     *
+     * This is a thin wrapper around std::vector, whose subscript operator rejects raw integers and indices of other
+     * strong types.
+     */
+    template <typename IndexT, typename ValueT, typename AllocatorT = std::allocator<ValueT>>
+    class typed_vector
+    {
+        static_assert(is_indexable_v<IndexT>, "typed_vector requires an indexable strong type as its index type");
+
+        using container_type = std::vector<ValueT, AllocatorT>;
+
+    public:
+        using index_type = IndexT;
+        using value_type = ValueT;
+        using allocator_type = AllocatorT;
+        using size_type = typename container_type::size_type;
+        using difference_type = typename container_type::difference_type;
+        using reference = typename container_type::reference;
+        using const_reference = typename container_type::const_reference;
+        using pointer = typename container_type::pointer;
+        using const_pointer = typename container_type::const_pointer;
+        using iterator = typename container_type::iterator;
+        using const_iterator = typename container_type::const_iterator;
+
+        typed_vector() = default;
+
+        explicit typed_vector(const AllocatorT &alloc) : _values(alloc)
+        {
+        }
+
+        explicit typed_vector(size_type count, const AllocatorT &alloc = AllocatorT()) : _values(count, alloc)
+        {
+        }
+
+        typed_vector(size_type count, const ValueT &value, const AllocatorT &alloc = AllocatorT()) :
+            _values(count, value, alloc)
+        {
+        }
+
+        typed_vector(std::initializer_list<ValueT> values, const AllocatorT &alloc = AllocatorT()) :
+            _values(values, alloc)
+        {
+        }
+
+        reference operator[](const IndexT &idx) noexcept
+        {
+            assert(details::to_position(idx) < _values.size());
+            return _values[details::to_position(idx)];
+        }
+
+        const_reference operator[](const IndexT &idx) const noexcept
+        {
+            assert(details::to_position(idx) < _values.size());
+            return _values[details::to_position(idx)];
+        }
+
+        reference at(const IndexT &idx)
+        {
+            return _values.at(details::to_position(idx));
+        }
+
+        const_reference at(const IndexT &idx) const
+        {
+            return _values.at(details::to_position(idx));
+        }
+
+        bool contains(const IndexT &idx) const noexcept
+        {
+            return details::to_position(idx) < _values.size();
+        }
+
+        /** Index of the next element to be appended */
+        IndexT next_index() const noexcept
+        {
+            return details::from_position<IndexT>(_values.size());
+        }
+
+        /** Appends a value, and returns its index */
+        IndexT push_back(const ValueT &value)
+        {
+            _values.push_back(value);
+            return details::from_position<IndexT>(_values.size() - 1);
+        }
+
+        IndexT push_back(ValueT &&value)
+        {
+            _values.push_back(std::move(value));
+            return details::from_position<IndexT>(_values.size() - 1);
+        }
+
+        template <typename ...Args>
+        reference emplace_back(Args &&...args)
+        {
+            return _values.emplace_back(std::forward<Args>(args)...);
+        }
+
+        void pop_back()
+        {
+            _values.pop_back();
+        }
+
+        reference front() noexcept
+        {
+            return _values.front();
+        }
+
+        const_reference front() const noexcept
+        {
+            return _values.front();
+        }
+
+        reference back() noexcept
+        {
+            return _values.back();
+        }
+
+        const_reference back() const noexcept
+        {
+            return _values.back();
+        }
+
+        pointer data() noexcept
+        {
+            return _values.data();
+        }
+
+        const_pointer data() const noexcept
+        {
+            return _values.data();
+        }
+
+        iterator begin() noexcept
+        {
+            return _values.begin();
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return _values.begin();
+        }
+
+        iterator end() noexcept
+        {
+            return _values.end();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return _values.end();
+        }
+
+        size_type size() const noexcept
+        {
+            return _values.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return _values.empty();
+        }
+
+        size_type capacity() const noexcept
+        {
+            return _values.capacity();
+        }
+
+        void reserve(size_type count)
+        {
+            _values.reserve(count);
+        }
+
+        void resize(size_type count)
+        {
+            _values.resize(count);
+        }
+
+        void resize(size_type count, const ValueT &value)
+        {
+            _values.resize(count, value);
+        }
+
+        void clear() noexcept
+        {
+            _values.clear();
+        }
+
+        /** The underlying std::vector, indexed by raw positions */
+        const container_type &underlying() const noexcept
+        {
+            return _values;
+        }
+
+        friend bool operator==(const typed_vector &lhs, const typed_vector &rhs)
+        {
+            return lhs._values == rhs._values;
+        }
+
+        friend bool operator!=(const typed_vector &lhs, const typed_vector &rhs)
+        {
+            return lhs._values != rhs._values;
+        }
+
+    private:
+        container_type _values;
+    };
+}
+
+#endif /* !STRONG_TYPE_TYPED_VECTOR_HPP */
@@ -10,10 +10,22 @@
 
 namespace st
 {
+    /** Whether T stands for an element of a strong type, such as a packed_reference, and has a value() member */
     template <typename T>
-    constexpr inline auto &&unwrap(T &&t) noexcept
+    struct is_strong_proxy : std::false_type
     {
-        if constexpr (is_strong_type_v<std::remove_cv_t<std::remove_reference_t<T>>>) {
+    };
+
+    template <typename T>
+    inline constexpr const bool is_strong_proxy_v = is_strong_proxy<T>::value;
+
+    /** Returns the value held by a strong type or a strong proxy, forwards anything else */
+    template <typename T>
+    constexpr inline decltype(auto) unwrap(T &&t) noexcept
+    {
+        using plain_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+        if constexpr (is_strong_type_v<plain_t> || is_strong_proxy_v<plain_t>) {
             return std::forward<T>(t).value();
         } else {
             return std::forward<T>(t);
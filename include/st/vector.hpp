@@ -0,0 +1,428 @@
+/*
+** Created by doom on 17/10/26.
+*/
+
+#ifndef STRONG_TYPE_VECTOR_HPP
+#define STRONG_TYPE_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <st/relocate.hpp>
+
+namespace st
+{
+    /**
+     * Contiguous container using st::relocate to move its elements around
+     *
+     * Growth, insertion and erasure move trivially relocatable elements with memmove instead of moving and destroying
+     * them one by one. Elements which are not trivially relocatable must be nothrow move constructible.
+     */
+    template <typename T>
+    class vector
+    {
+        static_assert(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>,
+                      "st::vector requires a trivially relocatable or nothrow move constructible type");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        vector() noexcept = default;
+
+        explicit vector(size_type count) : vector()
+        {
+            resize(count);
+        }
+
+        vector(size_type count, const T &value) : vector()
+        {
+            resize(count, value);
+        }
+
+        vector(std::initializer_list<T> values) : vector()
+        {
+            _reallocate(values.size());
+            for (const auto &v : values)
+                _unchecked_emplace_back(v);
+        }
+
+        vector(const vector &other) : vector()
+        {
+            _reallocate(other.size());
+            for (const auto &v : other)
+                _unchecked_emplace_back(v);
+        }
+
+        vector(vector &&other) noexcept :
+            _begin(std::exchange(other._begin, nullptr)),
+            _end(std::exchange(other._end, nullptr)),
+            _capacity(std::exchange(other._capacity, nullptr))
+        {
+        }
+
+        vector &operator=(const vector &other)
+        {
+            if (this != &other) {
+                vector copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        vector &operator=(vector &&other) noexcept
+        {
+            vector moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+
+        ~vector()
+        {
+            clear();
+            _deallocate(_begin, capacity());
+        }
+
+        void swap(vector &other) noexcept
+        {
+            std::swap(_begin, other._begin);
+            std::swap(_end, other._end);
+            std::swap(_capacity, other._capacity);
+        }
+
+        reference operator[](size_type pos) noexcept
+        {
+            return _begin[pos];
+        }
+
+        const_reference operator[](size_type pos) const noexcept
+        {
+            return _begin[pos];
+        }
+
+        reference at(size_type pos)
+        {
+            if (pos >= size())
+                throw std::out_of_range("st::vector::at: index out of range");
+            return _begin[pos];
+        }
+
+        const_reference at(size_type pos) const
+        {
+            if (pos >= size())
+                throw std::out_of_range("st::vector::at: index out of range");
+            return _begin[pos];
+        }
+
+        reference front() noexcept
+        {
+            return *_begin;
+        }
+
+        const_reference front() const noexcept
+        {
+            return *_begin;
+        }
+
+        reference back() noexcept
+        {
+            return _end[-1];
+        }
+
+        const_reference back() const noexcept
+        {
+            return _end[-1];
+        }
+
+        T *data() noexcept
+        {
+            return _begin;
+        }
+
+        const T *data() const noexcept
+        {
+            return _begin;
+        }
+
+        iterator begin() noexcept
+        {
+            return _begin;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return _begin;
+        }
+
+        iterator end() noexcept
+        {
+            return _end;
+        }
+
+        const_iterator end() const noexcept
+        {
+            return _end;
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        size_type size() const noexcept
+        {
+            return static_cast<size_type>(_end - _begin);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return static_cast<size_type>(_capacity - _begin);
+        }
+
+        bool empty() const noexcept
+        {
+            return _begin == _end;
+        }
+
+        void reserve(size_type count)
+        {
+            if (count > capacity())
+                _reallocate(count);
+        }
+
+        void shrink_to_fit()
+        {
+            if (_end != _capacity)
+                _reallocate(size());
+        }
+
+        void clear() noexcept
+        {
+            std::destroy(_begin, _end);
+            _end = _begin;
+        }
+
+        void resize(size_type count)
+        {
+            _resize(count);
+        }
+
+        void resize(size_type count, const T &value)
+        {
+            _resize(count, value);
+        }
+
+        template <typename ...Args>
+        reference emplace_back(Args &&...args)
+        {
+            if (_end == _capacity) {
+                const auto new_capacity = _grown_capacity(size() + 1);
+                T *new_begin = _allocate(new_capacity);
+                T *slot = new_begin + size();
+
+                try {
+                    ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    _deallocate(new_begin, new_capacity);
+                    throw;
+                }
+                _adopt(new_begin, relocate(_begin, _end, new_begin) + 1, new_capacity);
+                return *slot;
+            }
+            return _unchecked_emplace_back(std::forward<Args>(args)...);
+        }
+
+        void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back() noexcept
+        {
+            --_end;
+            _end->~T();
+        }
+
+        template <typename ...Args>
+        iterator emplace(const_iterator pos, Args &&...args)
+        {
+            const auto offset = pos - _begin;
+
+            if (_end == _capacity) {
+                const auto new_capacity = _grown_capacity(size() + 1);
+                T *new_begin = _allocate(new_capacity);
+                T *slot = new_begin + offset;
+
+                try {
+                    ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    _deallocate(new_begin, new_capacity);
+                    throw;
+                }
+                relocate(_begin, _begin + offset, new_begin);
+                T *new_end = relocate(_begin + offset, _end, slot + 1);
+                _adopt(new_begin, new_end, new_capacity);
+                return slot;
+            }
+
+            T *where = _begin + offset;
+
+            if (where == _end) {
+                _unchecked_emplace_back(std::forward<Args>(args)...);
+                return where;
+            }
+            /* The new value is built before shifting the tail, since args may refer to elements of the vector */
+            if constexpr (is_trivially_relocatable_v<T>) {
+                alignas(T) unsigned char buffer[sizeof(T)];
+                ::new (static_cast<void *>(buffer)) T(std::forward<Args>(args)...);
+                relocate(where, _end, where + 1);
+                relocate_at(reinterpret_cast<T *>(buffer), where);
+            } else {
+                T value(std::forward<Args>(args)...);
+                ::new (static_cast<void *>(_end)) T(std::move(_end[-1]));
+                std::move_backward(where, _end - 1, _end);
+                *where = std::move(value);
+            }
+            ++_end;
+            return where;
+        }
+
+        iterator insert(const_iterator pos, const T &value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T &&value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            T *from = _begin + (first - _begin);
+            T *to = _begin + (last - _begin);
+
+            if (from == to)
+                return from;
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::destroy(from, to);
+                _end = relocate(to, _end, from);
+            } else {
+                T *new_end = std::move(to, _end, from);
+                std::destroy(new_end, _end);
+                _end = new_end;
+            }
+            return from;
+        }
+
+        friend bool operator==(const vector &lhs, const vector &rhs)
+        {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator!=(const vector &lhs, const vector &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static T *_allocate(size_type count)
+        {
+            return std::allocator<T>().allocate(count);
+        }
+
+        static void _deallocate(T *p, size_type count) noexcept
+        {
+            if (p != nullptr)
+                std::allocator<T>().deallocate(p, count);
+        }
+
+        size_type _grown_capacity(size_type required) const noexcept
+        {
+            return std::max(required, capacity() * 2);
+        }
+
+        void _adopt(T *new_begin, T *new_end, size_type new_capacity) noexcept
+        {
+            _deallocate(_begin, capacity());
+            _begin = new_begin;
+            _end = new_end;
+            _capacity = new_begin + new_capacity;
+        }
+
+        void _reallocate(size_type new_capacity)
+        {
+            T *new_begin = _allocate(new_capacity);
+
+            _adopt(new_begin, relocate(_begin, _end, new_begin), new_capacity);
+        }
+
+        template <typename ...Args>
+        reference _unchecked_emplace_back(Args &&...args)
+        {
+            ::new (static_cast<void *>(_end)) T(std::forward<Args>(args)...);
+            return *_end++;
+        }
+
+        template <typename ...Args>
+        void _resize(size_type count, const Args &...args)
+        {
+            if (count <= size()) {
+                T *new_end = _begin + count;
+
+                std::destroy(new_end, _end);
+                _end = new_end;
+                return;
+            }
+            reserve(count);
+            while (size() < count)
+                _unchecked_emplace_back(args...);
+        }
+
+        T *_begin = nullptr;
+        T *_end = nullptr;
+        T *_capacity = nullptr;
+    };
+}
+
+#endif /* !STRONG_TYPE_VECTOR_HPP */
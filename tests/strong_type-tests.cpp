@@ -2,16 +2,47 @@
 ** Created by doom on 26/10/18.
 */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <gtest/gtest.h>
 #include <st/type.hpp>
 #include <st/st.hpp>
+#include <st/span.hpp>
+#include <st/batch.hpp>
+#include <st/hash.hpp>
+#include <st/typed_vector.hpp>
+#include <st/dense_map.hpp>
+#include <st/slot_map.hpp>
+#include <st/interned.hpp>
+#include <st/vector.hpp>
+#include <st/atomic.hpp>
+#include <st/sharded.hpp>
+#include <st/overflow.hpp>
+#include <st/bounded.hpp>
+#include <st/packed_vector.hpp>
+#include <st/quantity.hpp>
+#include <st/lazy.hpp>
+#include <st/algorithm.hpp>
+#include <st/parallel.hpp>
+#include <st/optional.hpp>
 
 using integer = st::type<
     int,
     struct integer_tag,
     st::arithmetic,
     st::addable_with<int>,
+    st::add_assignable_with<int>,
     st::hashable
 >;
 
@@ -52,6 +83,154 @@ namespace
 
 using name = st::type<std::string, struct name_tag>;
 
+namespace
+{
+    struct allocation_counter
+    {
+        static inline std::size_t allocations = 0;
+    };
+
+    template <typename T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() noexcept = default;
+
+        template <typename U>
+        constexpr counting_allocator(const counting_allocator<U> &) noexcept
+        {
+        }
+
+        T *allocate(std::size_t n)
+        {
+            ++allocation_counter::allocations;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n) noexcept
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U>
+        friend constexpr bool operator==(const counting_allocator &, const counting_allocator<U> &) noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        friend constexpr bool operator!=(const counting_allocator &, const counting_allocator<U> &) noexcept
+        {
+            return false;
+        }
+    };
+
+    using counted_string = std::basic_string<char, std::char_traits<char>, counting_allocator<char>>;
+
+    using counted_vector = std::vector<int, counting_allocator<int>>;
+
+    counted_vector operator+(const counted_vector &lhs, const counted_vector &rhs)
+    {
+        counted_vector ret;
+
+        ret.reserve(lhs.size() + rhs.size());
+        ret.insert(ret.end(), lhs.begin(), lhs.end());
+        ret.insert(ret.end(), rhs.begin(), rhs.end());
+        return ret;
+    }
+
+    counted_vector operator+(counted_vector &&lhs, const counted_vector &rhs)
+    {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return std::move(lhs);
+    }
+
+    struct bignum
+    {
+        std::vector<std::uint32_t, counting_allocator<std::uint32_t>> limbs;
+
+        void add(const bignum &other)
+        {
+            if (limbs.size() < other.limbs.size())
+                limbs.resize(other.limbs.size());
+
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < limbs.size(); ++i) {
+                std::uint64_t sum = carry + limbs[i] + (i < other.limbs.size() ? other.limbs[i] : 0);
+                limbs[i] = static_cast<std::uint32_t>(sum);
+                carry = sum >> 32;
+            }
+            if (carry)
+                limbs.push_back(static_cast<std::uint32_t>(carry));
+        }
+
+        friend bignum operator+(const bignum &lhs, const bignum &rhs)
+        {
+            bignum ret(lhs);
+
+            ret.add(rhs);
+            return ret;
+        }
+
+        friend bignum operator+(bignum &&lhs, const bignum &rhs)
+        {
+            lhs.add(rhs);
+            return std::move(lhs);
+        }
+    };
+
+    struct copy_counter
+    {
+        static inline std::size_t copies = 0;
+        static inline std::size_t moves = 0;
+
+        int n = 0;
+
+        copy_counter() noexcept = default;
+
+        explicit copy_counter(int i) noexcept : n(i)
+        {
+        }
+
+        copy_counter(const copy_counter &other) noexcept : n(other.n)
+        {
+            ++copies;
+        }
+
+        copy_counter(copy_counter &&other) noexcept : n(other.n)
+        {
+            ++moves;
+        }
+
+        copy_counter &operator=(const copy_counter &other) noexcept
+        {
+            n = other.n;
+            ++copies;
+            return *this;
+        }
+
+        copy_counter &operator=(copy_counter &&other) noexcept
+        {
+            n = other.n;
+            ++moves;
+            return *this;
+        }
+
+        copy_counter &operator+=(const copy_counter &other) noexcept
+        {
+            n += other.n;
+            return *this;
+        }
+
+        static void reset() noexcept
+        {
+            copies = 0;
+            moves = 0;
+        }
+    };
+}
+
 TEST(strong_type, is_strong_type)
 {
     static_assert(!st::is_strong_type_v<int>);
@@ -94,6 +273,114 @@ TEST(strong_type, noexceptness)
     static_assert(check_strong_type_noexceptness_v<integer, integer::value_type>);
     static_assert(check_strong_type_noexceptness_v<name, name::value_type>);
     static_assert(check_strong_type_noexceptness_v<with_a_member, int>);
+
+    static_assert(std::is_nothrow_default_constructible_v<integer>);
+    static_assert(std::is_nothrow_constructible_v<integer, const int &>);
+    static_assert(std::is_nothrow_constructible_v<integer, std::in_place_t, int>);
+    static_assert(!std::is_nothrow_constructible_v<name, const std::string &>);
+    static_assert(!std::is_nothrow_constructible_v<name, std::in_place_t, const char *>);
+    static_assert(std::is_nothrow_constructible_v<name, std::string &&>);
+}
+
+TEST(strong_type, in_place_construction)
+{
+    using counted = st::type<copy_counter, struct counted_tag, st::equality_comparable>;
+
+    static_assert(std::is_constructible_v<name, std::in_place_t, const char *, std::size_t>);
+    static_assert(!std::is_constructible_v<name, const char *, std::size_t>);
+    static_assert(!std::is_convertible_v<std::string, name>);
+    static_assert(std::is_same_v<decltype(st::make<name>(3, 'x')), name>);
+
+    const char buffer[] = "a buffer which is too long for the small string optimization";
+    ASSERT_EQ("a buffer", name(std::in_place, buffer, 8).value());
+    ASSERT_EQ("xxx", st::make<name>(3, 'x').value());
+
+    copy_counter::reset();
+    const auto made = st::make<counted>(1);
+    ASSERT_EQ(1, made.value().n);
+    ASSERT_EQ(0u, copy_counter::copies);
+    ASSERT_EQ(0u, copy_counter::moves);
+
+    std::vector<counted> values;
+    values.reserve(2);
+    copy_counter::reset();
+    values.emplace_back(std::in_place, 2);
+    ASSERT_EQ(0u, copy_counter::copies);
+    ASSERT_EQ(0u, copy_counter::moves);
+    values.emplace_back(copy_counter(3));
+    ASSERT_EQ(1u, copy_counter::moves);
+
+    std::map<int, counted> by_id;
+    copy_counter::reset();
+    by_id.try_emplace(4, std::in_place, 4);
+    ASSERT_EQ(0u, copy_counter::copies);
+    ASSERT_EQ(0u, copy_counter::moves);
+    ASSERT_EQ(4, by_id.at(4).value().n);
+}
+
+template <typename ST>
+static inline constexpr bool check_strong_type_layout_v =
+    sizeof(ST) == sizeof(typename ST::value_type) &&
+    alignof(ST) == alignof(typename ST::value_type) &&
+    sizeof(ST[7]) == sizeof(typename ST::value_type[7]) &&
+    std::is_standard_layout_v<ST> == std::is_standard_layout_v<typename ST::value_type> &&
+    std::is_trivially_copyable_v<ST> == std::is_trivially_copyable_v<typename ST::value_type>;
+
+template <typename T>
+struct layout_matrix
+{
+    struct three_bytes
+    {
+        char c[3];
+    };
+
+    template <typename ...Traits>
+    static constexpr bool check() noexcept
+    {
+        return check_strong_type_layout_v<st::type<T, struct layout_tag, Traits...>>;
+    }
+
+    static constexpr bool value =
+        check<>() &&
+        check<st::equality_comparable>() &&
+        check<st::arithmetic, st::orderable>() &&
+        check<st::orderable, st::arithmetic, st::equality_comparable, st::hashable>() &&
+        check<st::addable, st::addable_with<int>, st::addable, st::add_assignable, st::arithmetic>() &&
+        check<st::bitwise_manipulable, st::bitwise_orable, st::bitwise_or_assignable, st::equality_comparable>() &&
+        check_strong_type_layout_v<st::type<three_bytes, struct three_bytes_tag, st::hashable>>;
+};
+
+TEST(strong_type, layout)
+{
+    static_assert(layout_matrix<std::int8_t>::value);
+    static_assert(layout_matrix<std::uint16_t>::value);
+    static_assert(layout_matrix<std::int32_t>::value);
+    static_assert(layout_matrix<std::uint64_t>::value);
+    static_assert(layout_matrix<double>::value);
+    static_assert(layout_matrix<int *>::value);
+
+    static_assert(check_strong_type_layout_v<integer>);
+    static_assert(check_strong_type_layout_v<speed>);
+    static_assert(check_strong_type_layout_v<name>);
+    static_assert(check_strong_type_layout_v<st::type<std::string, struct text_tag, st::arithmetic, st::orderable>>);
+
+    using deduplicated = st::type<std::int32_t, struct deduplicated_tag, st::arithmetic, st::orderable>;
+    static_assert(std::is_base_of_v<st::traits::orderable<deduplicated>, deduplicated>);
+    static_assert(std::is_base_of_v<st::traits::add_assignable<deduplicated>, deduplicated>);
+    static_assert(std::is_convertible_v<const deduplicated &, const st::traits::orderable<deduplicated> &>);
+    static_assert(deduplicated(1) < deduplicated(2));
+}
+
+TEST(strong_type, construction)
+{
+    static_assert(std::is_constructible_v<integer, int>);
+    static_assert(std::is_default_constructible_v<integer>);
+    static_assert(!std::is_convertible_v<int, integer>);
+    static_assert(!std::is_constructible_v<speed, position>);
+    static_assert(!std::is_constructible_v<speed, const acceleration &>);
+    static_assert(!std::is_constructible_v<integer, with_a_member>);
+    static_assert(std::is_constructible_v<name, const char *>);
+    static_assert(std::is_nothrow_constructible_v<name, std::string &&>);
 }
 
 TEST(strong_type, addable)
@@ -103,6 +390,62 @@ TEST(strong_type, addable)
     static_assert((position(2) + 3).value() == position(5).value());
 }
 
+template <typename F>
+static std::size_t count_allocations(F &&f)
+{
+    allocation_counter::allocations = 0;
+    f();
+    return allocation_counter::allocations;
+}
+
+TEST(strong_type, addable_rvalues)
+{
+    using text = st::type<counted_string, struct text_tag, st::addable>;
+
+    const counted_string raw(24, 'a');
+    const text a(raw), b(raw), c(raw), d(raw);
+
+    auto raw_chain = count_allocations([&]() { auto r = raw + raw + raw + raw; (void)r; });
+    auto strong_chain = count_allocations([&]() { auto r = a + b + c + d; (void)r; });
+    ASSERT_EQ(raw_chain, strong_chain);
+
+    auto raw_right = count_allocations([&]() { auto r = raw + (raw + raw); (void)r; });
+    auto strong_right = count_allocations([&]() { auto r = a + (b + c); (void)r; });
+    ASSERT_EQ(raw_right, strong_right);
+
+    auto strong_copies = count_allocations([&]() {
+        text r = a + b;
+        const text &lvalue = r;
+        r = lvalue + c;
+        r = static_cast<const text &>(r) + d;
+    });
+    ASSERT_LT(strong_chain, strong_copies);
+    ASSERT_EQ(counted_string(96, 'a'), (a + b + c + d).value());
+}
+
+TEST(strong_type, addable_rvalues_heavy_payloads)
+{
+    using column = st::type<counted_vector, struct column_tag, st::addable>;
+    using big = st::type<bignum, struct big_tag, st::addable>;
+
+    const counted_vector raw(32, 1);
+    const column a(raw), b(raw), c(raw);
+
+    auto raw_chain = count_allocations([&]() { auto r = raw + raw + raw; (void)r; });
+    auto strong_chain = count_allocations([&]() { auto r = a + b + c; (void)r; });
+    ASSERT_EQ(raw_chain, strong_chain);
+    ASSERT_EQ(96u, (a + b + c).value().size());
+
+    bignum one;
+    one.limbs.assign(8, 0xFFFFFFFFu);
+    const big x(one), y(one), z(one);
+
+    auto raw_sum = count_allocations([&]() { auto r = one + one + one; (void)r; });
+    auto strong_sum = count_allocations([&]() { auto r = x + y + z; (void)r; });
+    ASSERT_EQ(raw_sum, strong_sum);
+    ASSERT_EQ(9u, (x + y + z).value().limbs.size());
+}
+
 TEST(strong_type, substractable)
 {
     static_assert((integer(1) - integer(1)).value() == integer(0).value());
@@ -132,6 +475,70 @@ TEST(strong_type, modulable)
     static_assert((integer(4) % integer(2)).value() == integer(0).value());
 }
 
+TEST(strong_type, compound_assignable)
+{
+    constexpr integer i = []() constexpr {
+        integer ret(1);
+
+        ret += integer(2);
+        ret -= integer(1);
+        ret *= integer(6);
+        ret /= integer(3);
+        ret %= integer(3);
+        ret += 4;
+        return ret;
+    }();
+
+    static_assert(i == integer(5));
+
+    using flags = st::type<uint8_t, struct flags_tag,
+        st::bitwise_manipulable, st::bitwise_or_assignable_with<uint8_t>, st::equality_comparable>;
+
+    constexpr flags f = []() constexpr {
+        flags ret(1);
+
+        ret |= flags(6);
+        ret &= flags(5);
+        ret ^= flags(1);
+        ret |= 8;
+        return ret;
+    }();
+
+    static_assert(f == flags(12));
+}
+
+TEST(strong_type, compound_assignable_in_place)
+{
+    using counted = st::type<copy_counter, struct counted_tag, st::add_assignable>;
+
+    counted total(copy_counter(0));
+    const counted delta(copy_counter(2));
+
+    copy_counter::reset();
+    for (int i = 0; i < 10; ++i) {
+        total += delta;
+    }
+    ASSERT_EQ(0u, copy_counter::copies);
+    ASSERT_EQ(0u, copy_counter::moves);
+    ASSERT_EQ(20, total.value().n);
+
+    using text = st::type<counted_string, struct text_tag, st::add_assignable, st::add_assignable_with<char>>;
+
+    text t(counted_string{});
+    t.value().reserve(64);
+    const text chunk(counted_string("abc"));
+    const char *buffer = t.value().data();
+
+    allocation_counter::allocations = 0;
+    for (int i = 0; i < 10; ++i) {
+        t += chunk;
+        t += '!';
+    }
+    ASSERT_EQ(0u, allocation_counter::allocations);
+    ASSERT_EQ(buffer, t.value().data());
+    ASSERT_EQ(40u, t.value().size());
+}
+
 TEST(strong_type, pre_incrementable)
 {
     constexpr integer i = []() constexpr {
@@ -271,6 +678,392 @@ TEST(strong_type, price_spread)
     static_assert(pe == price{60.0});
 }
 
+TEST(strong_type, overflow_policies)
+{
+    using wrapping = st::type<std::int32_t, struct wrapping_tag, st::arithmetic_wrapping>;
+    using saturating = st::type<std::int32_t, struct saturating_tag, st::arithmetic_saturating>;
+    using checked = st::type<std::int32_t, struct checked_tag, st::arithmetic_checked<>>;
+    using level = st::type<std::uint8_t, struct level_tag, st::addable_saturating, st::subtractable_saturating,
+        st::multiplicable_saturating, st::equality_comparable>;
+    using limits = std::numeric_limits<std::int32_t>;
+
+    static_assert(noexcept(std::declval<const wrapping &>() + std::declval<const wrapping &>()));
+    static_assert(noexcept(std::declval<const saturating &>() * std::declval<const saturating &>()));
+    static_assert(!noexcept(std::declval<const checked &>() + std::declval<const checked &>()));
+    static_assert(wrapping(limits::max()) + wrapping(1) == wrapping(limits::min()));
+    static_assert(saturating(limits::max()) + saturating(1) == saturating(limits::max()));
+    static_assert(checked(20) * checked(-3) == checked(-60));
+
+    ASSERT_EQ(wrapping(limits::min()), wrapping(limits::max()) + wrapping(1));
+    ASSERT_EQ(wrapping(limits::max()), wrapping(limits::min()) - wrapping(1));
+    ASSERT_EQ(wrapping(limits::min()), wrapping(limits::min()) / wrapping(-1));
+    ASSERT_EQ(wrapping(0), wrapping(limits::min()) % wrapping(-1));
+    ASSERT_EQ(wrapping(0), wrapping(7) / wrapping(0));
+    ASSERT_EQ(wrapping(0), wrapping(7) % wrapping(0));
+    wrapping w(limits::max());
+    ASSERT_EQ(wrapping(limits::min()), ++w);
+
+    ASSERT_EQ(saturating(limits::max()), saturating(limits::max() - 1) + saturating(5));
+    ASSERT_EQ(saturating(limits::min()), saturating(limits::min() + 1) + saturating(-5));
+    ASSERT_EQ(saturating(limits::min()), saturating(limits::min()) - saturating(1));
+    ASSERT_EQ(saturating(limits::max()), saturating(limits::max()) - saturating(-1));
+    ASSERT_EQ(saturating(limits::max()), saturating(1 << 20) * saturating(1 << 20));
+    ASSERT_EQ(saturating(limits::min()), saturating(-(1 << 20)) * saturating(1 << 20));
+    ASSERT_EQ(saturating(limits::max()), saturating(limits::min()) / saturating(-1));
+    ASSERT_EQ(saturating(-7), saturating(21) / saturating(-3));
+    ASSERT_EQ(saturating(limits::max()), saturating(21) / saturating(0));
+    ASSERT_EQ(saturating(limits::min()), saturating(-21) / saturating(0));
+    ASSERT_EQ(saturating(0), saturating(21) % saturating(0));
+    saturating s(limits::min());
+    s--;
+    ASSERT_EQ(saturating(limits::min()), s);
+    s *= saturating(2);
+    ASSERT_EQ(saturating(limits::min()), s);
+
+    ASSERT_EQ(level(255), level(200) + level(100));
+    ASSERT_EQ(level(0), level(100) - level(200));
+    ASSERT_EQ(level(255), level(16) * level(16));
+    ASSERT_EQ(level(225), level(15) * level(15));
+
+    ASSERT_THROW(checked(limits::max()) + checked(1), std::overflow_error);
+    ASSERT_THROW(checked(limits::min()) - checked(1), std::overflow_error);
+    ASSERT_THROW(checked(1 << 16) * checked(1 << 16), std::overflow_error);
+    ASSERT_THROW(checked(limits::min()) / checked(-1), std::overflow_error);
+    ASSERT_THROW(checked(1) / checked(0), std::overflow_error);
+    ASSERT_THROW(checked(1) % checked(0), std::overflow_error);
+    checked c(limits::max() - 1);
+    ASSERT_NO_THROW(++c);
+    ASSERT_THROW(++c, std::overflow_error);
+    ASSERT_EQ(checked(limits::max()), c);
+    ASSERT_THROW(c += checked(1), std::overflow_error);
+    ASSERT_EQ(checked(limits::max()), c);
+    ASSERT_EQ(checked(limits::max() - 9), c -= checked(9));
+}
+
+TEST(strong_type, bounded)
+{
+    using port = st::bounded<0, 65535, struct port_tag, st::equality_comparable, st::hashable>;
+    using priority = st::bounded<0, 7, struct priority_tag, st::arithmetic>;
+    using percent = st::bounded<0, 100, struct percent_tag, st::arithmetic>;
+    using offset = st::bounded<-1000, 1000, struct offset_tag, st::arithmetic>;
+
+    static_assert(std::is_same_v<port::value_type, std::uint16_t>);
+    static_assert(std::is_same_v<priority::value_type, std::uint8_t>);
+    static_assert(std::is_same_v<offset::value_type, std::int16_t>);
+    static_assert(std::is_same_v<st::bounded<-1, 4000000000, struct wide_tag>::value_type, std::int64_t>);
+    static_assert(sizeof(port) == 2 && sizeof(priority) == 1 && sizeof(offset) == 2);
+    static_assert(std::is_trivially_copyable_v<percent>);
+    static_assert(st::is_trivially_relocatable_v<percent>);
+    static_assert(percent::min_value == 0 && percent::max_value == 100);
+
+    static_assert(std::is_same_v<decltype(percent() + percent()),
+                  st::bounded<0, 200, struct percent_tag, st::arithmetic>>);
+    static_assert(std::is_same_v<decltype(percent() - percent()),
+                  st::bounded<-100, 100, struct percent_tag, st::arithmetic>>);
+    static_assert(std::is_same_v<decltype(offset() * offset()),
+                  st::bounded<-1000000, 1000000, struct offset_tag, st::arithmetic>>);
+    static_assert(noexcept(percent() + percent()));
+    static_assert(!noexcept(percent(1)));
+    static_assert((percent(60) + percent(70)).value() == 130);
+
+    ASSERT_EQ(port(8080), port(8080u));
+    ASSERT_THROW(port(65536), std::out_of_range);
+    ASSERT_THROW(port(-1), std::out_of_range);
+    ASSERT_THROW(priority(8), std::out_of_range);
+    ASSERT_THROW((st::bounded<-10, -1, struct negative_tag>(5u)), std::out_of_range);
+    ASSERT_THROW((st::bounded<-10, -1, struct negative_tag>(0u)), std::out_of_range);
+    ASSERT_EQ(-5, (st::bounded<-10, -1, struct negative_tag>(-5).value()));
+    ASSERT_EQ(std::hash<port>()(port(80)), std::hash<std::uint16_t>()(80));
+
+    const percent a(60);
+    const percent b(70);
+    auto sum = a + b;
+    ASSERT_EQ(130, sum.value());
+    ASSERT_TRUE(sum > a);
+    ASSERT_TRUE(a < sum);
+    ASSERT_EQ(-10, (a - b).value());
+    ASSERT_EQ(a + b, b + a);
+    ASSERT_TRUE(a - b < percent(0));
+    ASSERT_THROW(percent(sum.value()), std::out_of_range);
+    ASSERT_EQ(percent(65), percent(sum.value() / 2));
+
+    percent p(99);
+    ASSERT_EQ(percent(100), ++p);
+    ASSERT_THROW(++p, std::out_of_range);
+    ASSERT_EQ(percent(100), p);
+    ASSERT_THROW(p += percent(1), std::out_of_range);
+    ASSERT_EQ(percent(50), p -= percent(50));
+    ASSERT_THROW(p -= percent(51), std::out_of_range);
+    ASSERT_EQ(percent(100), p *= percent(2));
+    ASSERT_EQ(percent(25), p /= percent(4));
+    ASSERT_EQ(percent(1), p % percent(3));
+
+    offset o(-1000);
+    ASSERT_THROW(o--, std::out_of_range);
+    ASSERT_EQ(offset(-1000), o);
+    ASSERT_EQ(offset(), offset(0));
+    using teen = st::bounded<13, 19, struct teen_tag, st::equality_comparable>;
+    ASSERT_EQ(teen(13), teen());
+}
+
+TEST(strong_type, packed_vector)
+{
+    using priority = st::bounded<0, 7, struct priority_tag, st::equality_comparable, st::orderable>;
+    using teen = st::bounded<13, 19, struct teen_tag, st::equality_comparable>;
+    using offset = st::bounded<-1000, 1000, struct offset_tag, st::equality_comparable>;
+    using sample = st::type<std::uint32_t, struct sample_tag, st::equality_comparable>;
+
+    static_assert(st::packed_vector<priority>::bits_per_value == 3);
+    static_assert(st::packed_vector<teen>::bits_per_value == 3);
+    static_assert(st::packed_vector<offset>::bits_per_value == 11);
+    static_assert(st::packed_vector<sample>::bits_per_value == 32);
+    static_assert(std::is_same_v<decltype(st::unwrap(std::declval<st::packed_reference<priority, 3>>())),
+                  std::uint8_t>);
+
+    st::packed_vector<priority> priorities{priority(1), priority(7), priority(3)};
+    ASSERT_EQ(3u, priorities.size());
+    ASSERT_EQ(priority(7), priorities[1]);
+    ASSERT_TRUE(priorities[0] < priorities[2]);
+    ASSERT_EQ(7, st::unwrap(priorities[1]));
+
+    priorities[0] = priority(5);
+    priorities[2] = priorities[0];
+    ASSERT_EQ(priority(5), priorities.front());
+    ASSERT_EQ(priority(5), priorities.back());
+    swap(priorities[0], priorities[1]);
+    ASSERT_EQ(priority(7), priorities[0]);
+    ASSERT_EQ(priority(5), priorities[1]);
+    ASSERT_THROW(priorities.at(3), std::out_of_range);
+
+    std::sort(priorities.begin(), priorities.end());
+    const auto &sorted = priorities;
+    ASSERT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+    ASSERT_EQ(priority(5), *sorted.begin());
+    ASSERT_EQ(3, sorted.end() - sorted.begin());
+
+    for (int i = 0; i < 100; ++i)
+        priorities.push_back(priority(i % 8));
+    priority levels[90];
+    priorities.unpack(7, levels);
+    for (int i = 0; i < 90; ++i)
+        ASSERT_EQ(priority((i + 4) % 8), levels[i]);
+
+    st::packed_vector<offset> offsets;
+    for (int i = -1000; i <= 1000; ++i)
+        offsets.push_back(offset(i));
+    ASSERT_EQ(2001u, offsets.size());
+    offsets.shrink_to_fit();
+    ASSERT_EQ(345u * 8u, offsets.memory_usage());
+    ASSERT_EQ(offset(-1000), offsets[0]);
+    ASSERT_EQ(offset(1000), offsets[2000]);
+
+    for (std::size_t first : {0, 1, 5, 8, 13}) {
+        std::vector<offset> out(offsets.size() - first - 3);
+        offsets.unpack(first, out);
+        for (std::size_t i = 0; i < out.size(); ++i)
+            ASSERT_EQ(offsets[first + i], out[i]);
+    }
+
+    st::packed_vector<sample, 20> samples(100, sample(0xFFFFF));
+    ASSERT_THROW(samples.push_back(sample(1u << 20)), std::out_of_range);
+    ASSERT_THROW(samples[0] = sample(1u << 20), std::out_of_range);
+    samples[50] = sample(42);
+    std::vector<sample> unpacked(samples.size());
+    samples.unpack(0, unpacked);
+    ASSERT_EQ(sample(42), unpacked[50]);
+    ASSERT_EQ(sample(0xFFFFF), unpacked[99]);
+
+    st::packed_vector<sample, 20> copy = samples;
+    ASSERT_EQ(samples, copy);
+    copy.pop_back();
+    ASSERT_NE(samples, copy);
+}
+
+namespace
+{
+    template <typename LhsT, typename RhsT, typename = void>
+    struct has_add_assign : std::false_type
+    {
+    };
+
+    template <typename LhsT, typename RhsT>
+    struct has_add_assign<LhsT, RhsT, std::void_t<decltype(std::declval<LhsT &>() += std::declval<RhsT>())>> :
+        std::true_type
+    {
+    };
+}
+
+TEST(strong_type, quantity)
+{
+    namespace dim = st::dimensions;
+
+    using meters = st::quantity<double, dim::length>;
+    using kilometers = st::quantity<double, dim::length, std::kilo>;
+    using seconds = st::quantity<double, dim::time>;
+    using hours = st::quantity<double, dim::time, std::ratio<3600>>;
+    using km_per_hour = st::quantity<double, dim::velocity, std::ratio<1000, 3600>>;
+    using int_seconds = st::quantity<std::int64_t, dim::time>;
+    using milliseconds = st::quantity<std::int64_t, dim::time, std::milli>;
+    using bytes = st::quantity<std::uint64_t, dim::information>;
+    using mebibytes = st::quantity<std::uint64_t, dim::information, std::ratio<1024 * 1024>>;
+
+    static_assert(std::is_same_v<st::dimension_multiply_t<dim::velocity, dim::time>, dim::length>);
+    static_assert(std::is_same_v<st::quantity<int, st::dimension<1, 0, 0>>, st::quantity<int, dim::length>>);
+    static_assert(std::is_same_v<decltype(kilometers(1) / hours(1)), km_per_hour>);
+    static_assert(std::is_same_v<decltype(meters(1) * meters(1)), st::quantity<double, dim::area>>);
+    static_assert(std::is_same_v<decltype(meters(1) / meters(1)), st::quantity<double, dim::scalar>>);
+    static_assert(std::is_same_v<decltype(1.0 / seconds(1)), st::quantity<double, dim::frequency>>);
+    static_assert(std::is_same_v<decltype(int_seconds(1) + milliseconds(1)), milliseconds>);
+    static_assert(std::is_same_v<km_per_hour::dimension_type, dim::velocity>);
+    static_assert(std::is_same_v<km_per_hour::ratio_type, std::ratio<5, 18>>);
+    static_assert(st::is_quantity_v<meters> && !st::is_quantity_v<integer>);
+    static_assert(sizeof(meters) == sizeof(double));
+    static_assert(!std::is_constructible_v<meters, seconds>);
+
+    static_assert(st::quantity_cast<milliseconds>(int_seconds(3)).value() == 3000);
+    static_assert(st::quantity_cast<int_seconds>(milliseconds(3999)).value() == 3);
+    static_assert((int_seconds(1) + milliseconds(500)).value() == 1500);
+    static_assert(int_seconds(2) == milliseconds(2000));
+    static_assert(milliseconds(1999) < int_seconds(2));
+    static_assert(has_add_assign<milliseconds, int_seconds>::value);
+    static_assert(!has_add_assign<int_seconds, milliseconds>::value);
+    static_assert(!has_add_assign<meters, seconds>::value);
+
+    ASSERT_DOUBLE_EQ(36.0, st::quantity_cast<km_per_hour>(meters(100) / seconds(10)).value());
+    ASSERT_DOUBLE_EQ(2.5, (kilometers(2) + meters(500)).value() / 1000);
+    ASSERT_TRUE(kilometers(1) > meters(999));
+    ASSERT_EQ(mebibytes(3), st::quantity_cast<mebibytes>(bytes(3 * 1024 * 1024 + 1)));
+    ASSERT_EQ(meters(-5), -meters(5));
+    ASSERT_EQ(meters(20), 2.0 * meters(10));
+    ASSERT_EQ(meters(5), meters(10) / 2.0);
+
+    milliseconds elapsed(250);
+    elapsed += int_seconds(1);
+    ASSERT_EQ(milliseconds(1250), elapsed);
+    elapsed -= milliseconds(250);
+    elapsed *= 3;
+    ASSERT_EQ(int_seconds(3), elapsed);
+}
+
+TEST(strong_type, lazy_arithmetic)
+{
+    using samples = std::vector<double, counting_allocator<double>>;
+    using spectrum = st::type<samples, struct spectrum_tag, st::lazy_arithmetic, st::equality_comparable>;
+    using point = st::type<std::array<double, 3>, struct point_tag, st::lazy_arithmetic>;
+
+    const spectrum a(samples{1, 2, 3});
+    const spectrum b(samples{4, 5, 6});
+    const spectrum c(samples{7, 8, 9});
+
+    static_assert(!std::is_same_v<decltype(a + b), spectrum>);
+    static_assert(std::is_convertible_v<decltype(a + b * 2.0 - c / 2.0), spectrum>);
+
+    spectrum r;
+    auto fused = count_allocations([&]() { r = a + b * 2.0 + c; });
+    ASSERT_EQ(1u, fused);
+    ASSERT_EQ(spectrum(samples{16, 20, 24}), r);
+
+    auto in_place = count_allocations([&]() {
+        r -= a * b;
+        r *= 0.5;
+        r += -c;
+    });
+    ASSERT_EQ(0u, in_place);
+    ASSERT_EQ(spectrum(samples{-1, -3, -6}), r);
+
+    const auto held = spectrum(samples{1, 1, 1}) + 2.0 * a;
+    spectrum from_temporary = held;
+    ASSERT_EQ(spectrum(samples{3, 5, 7}), from_temporary);
+    ASSERT_EQ(3u, held.size());
+    ASSERT_EQ(7.0, held[2]);
+
+    const point p(std::array<double, 3>{1, 2, 3});
+    const point q = -p + p * 3.0;
+    ASSERT_EQ((std::array<double, 3>{2, 4, 6}), q.value());
+}
+
+TEST(strong_type, algorithm)
+{
+    using timestamp = st::type<std::uint64_t, struct timestamp_tag, st::orderable, st::equality_comparable>;
+    using offset = st::type<std::int32_t, struct offset_tag, st::orderable, st::equality_comparable>;
+    using reading = st::type<double, struct reading_tag, st::orderable>;
+    using name = st::type<std::string, struct name_tag, st::orderable, st::equality_comparable>;
+
+    static_assert(st::details::uses_radix_sort_v<std::vector<timestamp>::iterator>);
+    static_assert(st::details::uses_radix_sort_v<reading *>);
+    static_assert(!st::details::uses_radix_sort_v<std::vector<name>::iterator>);
+    static_assert(!st::details::uses_radix_sort_v<std::vector<std::uint64_t>::iterator>);
+
+    std::mt19937_64 rng(42);
+    const auto check_sort = [](auto values) {
+        auto expected = values;
+
+        std::sort(expected.begin(), expected.end());
+        st::sort(values.begin(), values.end());
+        ASSERT_EQ(expected, values);
+    };
+
+    for (std::size_t n : {0, 1, 100, 255, 256, 10000}) {
+        std::vector<timestamp> wide, narrow, two_digits, shared_high;
+        std::vector<offset> offsets;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto r = rng();
+
+            wide.emplace_back(r);
+            narrow.emplace_back(r % 200);
+            two_digits.emplace_back(r % 60000);
+            shared_high.emplace_back(0x1234567800000000u + r % 100000);
+            offsets.emplace_back(static_cast<std::int32_t>(r));
+        }
+        check_sort(wide);
+        check_sort(narrow);
+        check_sort(two_digits);
+        check_sort(shared_high);
+        check_sort(offsets);
+        check_sort(std::vector<timestamp>(n, timestamp(7)));
+    }
+
+    std::vector<reading> readings;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const double r = static_cast<double>(rng() % 2000) - 1000.0;
+
+        readings.emplace_back(i % 7 == 0 ? (i % 2 ? -0.0 : 0.0) : r / 8);
+    }
+    readings.emplace_back(std::numeric_limits<double>::infinity());
+    readings.emplace_back(-std::numeric_limits<double>::infinity());
+    readings.emplace_back(std::numeric_limits<double>::denorm_min());
+    readings.emplace_back(-std::numeric_limits<double>::max());
+
+    auto expected = readings;
+    std::stable_sort(expected.begin(), expected.end());
+    st::stable_sort(readings.begin(), readings.end());
+    for (std::size_t i = 0; i < readings.size(); ++i) {
+        /* Distinguishes -0.0 from +0.0, which stable sorts must keep in order */
+        ASSERT_EQ(std::signbit(expected[i].value()), std::signbit(readings[i].value()));
+        ASSERT_EQ(expected[i].value(), readings[i].value());
+    }
+
+    std::vector<name> names{name("b"), name("c"), name("a")};
+    st::sort(names.begin(), names.end());
+    ASSERT_EQ((std::vector<name>{name("a"), name("b"), name("c")}), names);
+    ASSERT_EQ(names.begin() + 1, st::lower_bound(names.begin(), names.end(), name("b")));
+
+    std::vector<timestamp> sorted;
+    for (std::uint64_t v : {1, 3, 3, 3, 5, 8, 13, 13, 21})
+        sorted.emplace_back(v);
+    for (std::size_t size = 0; size <= sorted.size(); ++size) {
+        const auto last = sorted.begin() + static_cast<std::ptrdiff_t>(size);
+
+        for (std::uint64_t v = 0; v < 23; ++v) {
+            ASSERT_EQ(std::lower_bound(sorted.begin(), last, timestamp(v)),
+                      st::lower_bound(sorted.begin(), last, timestamp(v)));
+            ASSERT_EQ(std::upper_bound(sorted.begin(), last, timestamp(v)),
+                      st::upper_bound(sorted.begin(), last, timestamp(v)));
+        }
+    }
+}
+
 TEST(strong_type, hashable)
 {
     auto hasher = std::hash<integer>();
@@ -278,3 +1071,874 @@ TEST(strong_type, hashable)
 
     ASSERT_EQ(underlying_hasher(1), hasher(integer(1)));
 }
+
+TEST(strong_type, hash_policies)
+{
+    using entity_id = st::type<std::uint32_t, struct entity_id_tag,
+        st::hashable_with<st::hash_policies::fibonacci>, st::equality_comparable>;
+    using digest = st::type<std::uint64_t, struct digest_tag, st::hashable_with<st::hash_policies::identity>>;
+    using path = st::type<std::string, struct path_tag,
+        st::hashable_with<st::hash_policies::wyhash>, st::equality_comparable, st::lookupable_with<std::string_view>>;
+
+    static_assert(std::is_same_v<st::details::hash_policy_t<integer>, st::hash_policies::standard>);
+    static_assert(std::is_same_v<st::details::hash_policy_t<path>, st::hash_policies::wyhash>);
+    static_assert(std::is_empty_v<st::traits::hashable<path, st::hash_policies::wyhash>>);
+    static_assert(!std::is_invocable_v<std::hash<entity_id>, const with_a_member &>);
+
+    ASSERT_EQ(st::hash_policies::fibonacci()(42u), std::hash<entity_id>()(entity_id(42)));
+    ASSERT_NE(std::hash<entity_id>()(entity_id(1)) + 1, std::hash<entity_id>()(entity_id(2)));
+    ASSERT_EQ(0xdeadbeefu, std::hash<digest>()(digest(0xdeadbeef)));
+
+    const std::string long_path(100, 'x');
+    for (const auto &s : {std::string(), std::string("ab"), std::string("/usr"), std::string("/usr/local/bin"),
+                          std::string("/usr/local/share/doc"), long_path}) {
+        ASSERT_EQ(std::hash<path>()(path(s)), st::hash<path>()(std::string_view(s)));
+        ASSERT_EQ(std::hash<path>()(path(s)), st::hash<path>()(s));
+    }
+    ASSERT_NE(std::hash<path>()(path("/usr/bin")), std::hash<path>()(path("/usr/bim")));
+    ASSERT_NE(std::hash<path>()(path(long_path)), std::hash<path>()(path(long_path + 'x')));
+
+    std::unordered_map<entity_id, int> entities;
+    for (std::uint32_t i = 0; i < 1000; ++i)
+        entities.emplace(entity_id(i * 64), static_cast<int>(i));
+    ASSERT_EQ(1000u, entities.size());
+    ASSERT_EQ(10, entities.at(entity_id(640)));
+}
+
+namespace
+{
+    template <typename ContainerT, typename IndexT, typename = void>
+    struct is_subscriptable_by : std::false_type
+    {
+    };
+
+    template <typename ContainerT, typename IndexT>
+    struct is_subscriptable_by<ContainerT, IndexT,
+        std::void_t<decltype(std::declval<ContainerT &>()[std::declval<IndexT>()])>> : std::true_type
+    {
+    };
+}
+
+TEST(strong_type, typed_vector)
+{
+    using node_id = st::type<std::uint32_t, struct node_id_tag, st::indexable, st::equality_comparable>;
+    using edge_id = st::type<std::uint32_t, struct edge_id_tag, st::indexable>;
+    using nodes = st::typed_vector<node_id, std::string>;
+
+    static_assert(st::is_indexable_v<node_id>);
+    static_assert(!st::is_indexable_v<integer>);
+    static_assert(!st::is_indexable_v<std::size_t>);
+    static_assert(is_subscriptable_by<nodes, node_id>::value);
+    static_assert(!is_subscriptable_by<nodes, std::size_t>::value);
+    static_assert(!is_subscriptable_by<nodes, edge_id>::value);
+
+    nodes names;
+    ASSERT_EQ(node_id(0), names.next_index());
+    const auto root = names.push_back("root");
+    const auto leaf = names.push_back("leaf");
+    ASSERT_EQ(node_id(1), leaf);
+    ASSERT_EQ("root", names[root]);
+    names[leaf] += "!";
+    ASSERT_EQ("leaf!", names.at(leaf));
+    ASSERT_TRUE(names.contains(leaf));
+    ASSERT_FALSE(names.contains(node_id(2)));
+    ASSERT_THROW(names.at(node_id(2)), std::out_of_range);
+    ASSERT_EQ(names.underlying().data(), names.data());
+}
+
+TEST(strong_type, dense_map)
+{
+    using node_id = st::type<std::uint32_t, struct node_id_tag, st::indexable, st::equality_comparable>;
+    using small_id = st::type<std::uint8_t, struct small_id_tag, st::indexable>;
+
+    static_assert(!is_subscriptable_by<st::dense_map<node_id, int>, std::uint32_t>::value);
+
+    st::dense_map<node_id, std::string> labels;
+    ASSERT_TRUE(labels.insert(node_id(7), "seven").second);
+    ASSERT_FALSE(labels.insert(node_id(7), "sept").second);
+    labels[node_id(3)] = "three";
+    labels.try_emplace(node_id(12), 3, 'x');
+    ASSERT_EQ(3u, labels.size());
+    ASSERT_EQ("seven", labels.at(node_id(7)));
+    ASSERT_EQ("xxx", *labels.find(node_id(12)));
+    ASSERT_EQ(labels.end(), labels.find(node_id(4)));
+    ASSERT_EQ(labels.end(), labels.find(node_id(100)));
+    ASSERT_THROW(labels.at(node_id(100)), std::out_of_range);
+
+    ASSERT_EQ(1u, labels.erase(node_id(7)));
+    ASSERT_EQ(0u, labels.erase(node_id(7)));
+    ASSERT_FALSE(labels.contains(node_id(7)));
+    ASSERT_EQ("xxx", labels.at(node_id(12)));
+    ASSERT_EQ(2u, labels.size());
+    for (auto it = labels.begin(); it != labels.end(); ++it)
+        ASSERT_EQ(labels.at(labels.key_of(it)), *it);
+
+    labels.clear();
+    ASSERT_TRUE(labels.empty());
+    ASSERT_FALSE(labels.contains(node_id(3)));
+
+    st::dense_map<small_id, int> all;
+    for (int i = 0; i < 256; ++i)
+        all[small_id(static_cast<std::uint8_t>(i))] = i;
+    ASSERT_EQ(256u, all.size());
+    ASSERT_EQ(255, all.at(small_id(255)));
+
+    using signed_id = st::type<int, struct signed_id_tag, st::indexable, st::equality_comparable>;
+
+    st::dense_map<signed_id, int> signed_keys;
+    signed_keys[signed_id(2)] = 5;
+    ASSERT_THROW(signed_keys[signed_id(-1)] = 5, std::out_of_range);
+    ASSERT_THROW(signed_keys.try_emplace(signed_id(std::numeric_limits<int>::min()), 1), std::out_of_range);
+    ASSERT_FALSE(signed_keys.contains(signed_id(-1)));
+    ASSERT_EQ(signed_keys.end(), signed_keys.find(signed_id(-2)));
+    ASSERT_EQ(0u, signed_keys.erase(signed_id(-1)));
+    ASSERT_EQ(1u, signed_keys.size());
+    ASSERT_EQ(5, signed_keys.at(signed_id(2)));
+
+    using wide_id = st::type<std::uint64_t, struct wide_id_tag, st::indexable>;
+
+    st::dense_map<wide_id, int> wide_keys;
+    ASSERT_THROW(wide_keys[wide_id(std::numeric_limits<std::uint64_t>::max())] = 1, std::length_error);
+    ASSERT_TRUE(wide_keys.empty());
+
+    struct fragile
+    {
+        explicit fragile(bool fail)
+        {
+            if (fail)
+                throw std::runtime_error("fragile");
+        }
+    };
+
+    st::dense_map<node_id, fragile> fragiles;
+    fragiles.try_emplace(node_id(1), false);
+    ASSERT_THROW(fragiles.try_emplace(node_id(4), true), std::runtime_error);
+    ASSERT_EQ(1u, fragiles.size());
+    ASSERT_FALSE(fragiles.contains(node_id(4)));
+    ASSERT_EQ(node_id(1), fragiles.key_of(fragiles.begin()));
+    ASSERT_TRUE(fragiles.try_emplace(node_id(4), false).second);
+    ASSERT_EQ(node_id(4), fragiles.key_of(std::next(fragiles.begin())));
+    ASSERT_EQ(1u, fragiles.erase(node_id(1)));
+    ASSERT_EQ(node_id(4), fragiles.key_of(fragiles.begin()));
+    ASSERT_EQ(1u, fragiles.size());
+}
+
+TEST(strong_type, slot_map)
+{
+    using entity = st::handle<struct entity_tag>;
+
+    static_assert(sizeof(entity) == sizeof(std::uint64_t));
+    static_assert(std::is_trivially_copyable_v<entity>);
+    static_assert(st::is_strong_type_v<entity>);
+    static_assert(!std::is_convertible_v<std::uint64_t, entity>);
+    static_assert(entity(3, 7).index() == 3 && entity(3, 7).generation() == 7);
+    ASSERT_EQ(std::hash<std::uint64_t>()(entity(3, 7).value()), std::hash<entity>()(entity(3, 7)));
+
+    st::slot_map<struct entity_tag, std::string> names;
+    const auto a = names.insert("a");
+    const auto b = names.emplace(2, 'b');
+    const auto c = names.insert("c");
+    ASSERT_FALSE(names.contains(entity()));
+    ASSERT_EQ("bb", names.at(b));
+    ASSERT_EQ(3u, names.size());
+
+    ASSERT_TRUE(names.erase(a));
+    ASSERT_FALSE(names.erase(a));
+    ASSERT_EQ(nullptr, names.get(a));
+    ASSERT_THROW(names.at(a), std::out_of_range);
+    ASSERT_EQ("c", *names.get(c));
+
+    const auto d = names.insert("d");
+    ASSERT_EQ(a.index(), d.index());
+    ASSERT_NE(a, d);
+    ASSERT_FALSE(names.contains(a));
+    ASSERT_EQ("d", names[d]);
+
+    std::unordered_map<entity, int> refs;
+    for (auto it = names.begin(); it != names.end(); ++it) {
+        ASSERT_EQ(*it, names.at(names.handle_of(it)));
+        refs[names.handle_of(it)] = 1;
+    }
+    ASSERT_EQ(3u, refs.size());
+
+    names.clear();
+    ASSERT_TRUE(names.empty());
+    ASSERT_FALSE(names.contains(b));
+    ASSERT_FALSE(names.contains(d));
+
+    struct fragile
+    {
+        explicit fragile(bool fail)
+        {
+            if (fail)
+                throw std::runtime_error("fragile");
+        }
+    };
+
+    st::slot_map<struct entity_tag, fragile> fragiles;
+    const auto first = fragiles.emplace(false);
+    ASSERT_THROW(fragiles.emplace(true), std::runtime_error);
+    ASSERT_EQ(1u, fragiles.size());
+    ASSERT_TRUE(fragiles.erase(first));
+    ASSERT_THROW(fragiles.emplace(true), std::runtime_error);
+    ASSERT_TRUE(fragiles.empty());
+    const auto second = fragiles.emplace(false);
+    ASSERT_EQ(first.index(), second.index());
+    ASSERT_FALSE(fragiles.contains(first));
+    ASSERT_TRUE(fragiles.contains(second));
+    const auto third = fragiles.emplace(false);
+    ASSERT_EQ(first.index() + 1, third.index());
+    ASSERT_EQ(fragiles.end(), std::next(fragiles.begin(), 2));
+    ASSERT_EQ(third, fragiles.handle_of(std::next(fragiles.begin())));
+}
+
+TEST(strong_type, interned)
+{
+    using symbol = st::interned<struct symbol_tag, st::equality_comparable, st::orderable, st::hashable,
+        st::lookupable_with<std::string_view>>;
+
+    static_assert(st::is_strong_type_v<symbol>);
+    static_assert(sizeof(symbol) == sizeof(void *));
+    static_assert(std::is_trivially_copyable_v<symbol>);
+    static_assert(std::is_same_v<decltype(st::unwrap(std::declval<const symbol &>())), const st::interned_string &>);
+    static_assert(!std::is_convertible_v<std::string_view, st::interned_string>);
+
+    const auto a = st::intern<symbol>("alpha");
+    const auto b = st::intern<symbol>(std::string("al") + "pha");
+    const auto c = st::intern<symbol>("beta");
+    ASSERT_EQ(a.value().c_str(), b.value().c_str());
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_LT(a, c);
+    ASSERT_EQ("alpha", a.value().view());
+    ASSERT_EQ(symbol(), st::intern<symbol>(""));
+    ASSERT_TRUE(symbol().value().empty());
+    ASSERT_EQ('\0', a.value().c_str()[5]);
+
+    ASSERT_EQ(std::hash<std::string_view>()("alpha"), std::hash<symbol>()(a));
+    ASSERT_EQ(std::hash<symbol>()(a), st::hash<symbol>()(std::string_view("alpha")));
+    ASSERT_TRUE(st::equal_to<>()(a, std::string_view("alpha")));
+    ASSERT_TRUE(st::less<symbol>()(std::string_view("alpha"), c));
+
+    std::map<symbol, int, st::less<>> ordered{{a, 1}, {c, 2}};
+    ASSERT_EQ(2, ordered.find(std::string_view("beta"))->second);
+
+    st::intern_pool pool;
+    const st::interned_string local("alpha", pool);
+    ASSERT_EQ(1u, pool.size());
+    ASSERT_NE(local.c_str(), a.value().c_str());
+    ASSERT_EQ(local.view(), a.value().view());
+
+    const std::string long_text(100000, 'z');
+    ASSERT_EQ(long_text, st::interned_string(long_text, pool).view());
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<const char *>> seen(4);
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&pool, &out = seen[t]]() {
+            for (int i = 0; i < 1000; ++i)
+                out.push_back(st::interned_string("key" + std::to_string(i), pool).c_str());
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    for (const auto &s : seen)
+        ASSERT_EQ(seen.front(), s);
+    ASSERT_EQ(1002u, pool.size());
+}
+
+TEST(strong_type, hash_cached)
+{
+    using blob = st::type<std::string, struct blob_tag, st::hash_cached, st::equality_comparable, st::addable,
+        st::add_assignable_with<std::string>, st::lookupable_with<std::string_view>>;
+
+    static_assert(std::is_base_of_v<st::hash_cached_storage<std::string, st::hash_policies::standard>, blob>);
+    static_assert(std::is_same_v<st::details::hash_policy_t<blob>, st::hash_policies::standard>);
+    static_assert(sizeof(blob) == sizeof(std::string) + sizeof(std::size_t));
+    static_assert(std::is_nothrow_move_constructible_v<blob>);
+    static_assert(!st::is_layout_compatible_v<blob>);
+
+    blob b("a rather long binary large object");
+    const auto expected = std::hash<std::string>()(b.value());
+    ASSERT_EQ(expected, b.cached_hash());
+    ASSERT_EQ(expected, std::hash<blob>()(b));
+    ASSERT_EQ(expected, st::hash<blob>()(b));
+    ASSERT_EQ(expected, st::hash<blob>()(std::string_view("a rather long binary large object")));
+
+    b += std::string("!");
+    ASSERT_EQ(std::hash<std::string>()("a rather long binary large object!"), std::hash<blob>()(b));
+    b.value().pop_back();
+    ASSERT_EQ(expected, std::hash<blob>()(b));
+
+    blob copy(b);
+    ASSERT_EQ(expected, std::hash<blob>()(copy));
+    blob moved(std::move(b));
+    ASSERT_EQ(expected, std::hash<blob>()(moved));
+    ASSERT_EQ(std::hash<std::string>()(b.value()), std::hash<blob>()(b));
+    b = copy + moved;
+    ASSERT_EQ(std::hash<std::string>()(b.value()), std::hash<blob>()(b));
+
+    std::unordered_map<blob, int> blobs;
+    blobs.emplace(blob("one"), 1);
+    blobs.emplace(blob("two"), 2);
+    blobs.rehash(1024);
+    ASSERT_EQ(2, blobs.at(blob("two")));
+
+    using short_id = st::type<std::uint64_t, struct short_id_tag, st::hash_cached_with<st::hash_policies::fibonacci>>;
+    ASSERT_EQ(st::hash_policies::fibonacci()(42u), std::hash<short_id>()(short_id(42u)));
+}
+
+TEST(strong_type, allocator_aware)
+{
+    using label = st::type<std::pmr::string, struct label_tag, st::equality_comparable>;
+    using allocator = std::pmr::polymorphic_allocator<label>;
+
+    static_assert(std::uses_allocator_v<label, allocator>);
+    static_assert(std::is_same_v<label::allocator_type, std::pmr::string::allocator_type>);
+    static_assert(!std::uses_allocator_v<integer, allocator>);
+    static_assert(std::is_constructible_v<label, std::allocator_arg_t, allocator, const char *>);
+    static_assert(std::is_constructible_v<label, std::allocator_arg_t, allocator, const label &>);
+    static_assert(std::is_constructible_v<label, const label &, allocator>);
+    static_assert(!std::is_constructible_v<name, std::allocator_arg_t, allocator, const char *>);
+
+    const std::string long_text(64, 'l');
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<label> labels(&arena);
+
+    labels.emplace_back(long_text.c_str());
+    labels.push_back(label(long_text.c_str()));
+    labels.emplace_back();
+    labels.resize(16);
+    for (const auto &l : labels)
+        ASSERT_EQ(&arena, l.value().get_allocator().resource());
+    ASSERT_EQ(long_text, labels.front().value().c_str());
+
+    std::pmr::monotonic_buffer_resource other_arena;
+    std::pmr::vector<label> copies(labels, &other_arena);
+    for (const auto &l : copies)
+        ASSERT_EQ(&other_arena, l.value().get_allocator().resource());
+    ASSERT_EQ(labels, copies);
+
+    const label moved(std::move(copies.front()), allocator(&arena));
+    ASSERT_EQ(&arena, moved.value().get_allocator().resource());
+    ASSERT_EQ(long_text, moved.value().c_str());
+
+    std::pmr::map<int, label> by_id(&arena);
+    by_id.emplace(1, long_text.c_str());
+    ASSERT_EQ(&arena, by_id.at(1).value().get_allocator().resource());
+
+    using key = st::type<std::pmr::string, struct key_tag, st::hash_cached, st::equality_comparable>;
+
+    static_assert(std::uses_allocator_v<key, allocator>);
+    static_assert(std::is_constructible_v<key, std::allocator_arg_t, allocator, const key &>);
+    static_assert(std::is_constructible_v<key, std::allocator_arg_t, allocator, key &&>);
+    static_assert(std::is_constructible_v<key, const key &, allocator>);
+    static_assert(std::is_constructible_v<key, key &&, allocator>);
+
+    const key k(long_text.c_str());
+    std::pmr::vector<key> keys(&arena);
+
+    keys.push_back(k);
+    keys.emplace_back(long_text.c_str());
+    keys.push_back(key(long_text.c_str()));
+    keys.resize(16);
+    for (const auto &elem : keys)
+        ASSERT_EQ(&arena, elem.value().get_allocator().resource());
+    for (std::size_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(k, keys[i]);
+        ASSERT_EQ(std::hash<std::pmr::string>()(k.value()), keys[i].cached_hash());
+    }
+
+    const key moved_key(std::move(keys.front()), allocator(&other_arena));
+    ASSERT_EQ(&other_arena, moved_key.value().get_allocator().resource());
+    ASSERT_EQ(k, moved_key);
+    ASSERT_EQ(k.cached_hash(), moved_key.cached_hash());
+}
+
+TEST(strong_type, trivially_relocatable)
+{
+    using owner = st::type<std::unique_ptr<int>, struct owner_tag>;
+    using relocatable_counter = st::type<copy_counter, struct relocatable_counter_tag, st::trivially_relocatable>;
+    using cached = st::type<std::unique_ptr<int>, struct cached_tag, st::hash_cached>;
+
+    static_assert(st::is_trivially_relocatable_v<int>);
+    static_assert(st::is_trivially_relocatable_v<integer>);
+    static_assert(st::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(st::is_trivially_relocatable_v<std::shared_ptr<int>>);
+    static_assert(st::is_trivially_relocatable_v<owner>);
+    static_assert(st::is_trivially_relocatable_v<relocatable_counter>);
+    static_assert(!st::is_trivially_relocatable_v<copy_counter>);
+    static_assert(!st::is_trivially_relocatable_v<std::unique_ptr<int, void (*)(int *)>>);
+    static_assert(!st::is_trivially_relocatable_v<cached>);
+#if defined(_LIBCPP_VERSION)
+    static_assert(st::is_trivially_relocatable_v<name>);
+#elif defined(__GLIBCXX__)
+    static_assert(!st::is_trivially_relocatable_v<name>);
+#endif
+
+    st::vector<owner> owners;
+    for (int i = 0; i < 10; ++i)
+        owners.emplace_back(std::make_unique<int>(i));
+    owners.erase(owners.begin() + 2, owners.begin() + 4);
+    owners.insert(owners.begin(), owner(std::make_unique<int>(-1)));
+    owners.emplace(owners.begin() + 5, std::make_unique<int>(42));
+    std::vector<int> values;
+    for (const auto &o : owners)
+        values.push_back(*o.value());
+    ASSERT_EQ((std::vector<int>{-1, 0, 1, 4, 5, 42, 6, 7, 8, 9}), values);
+
+    st::vector<relocatable_counter> counters;
+    copy_counter::reset();
+    for (int i = 0; i < 100; ++i)
+        counters.emplace_back(std::in_place, i);
+    counters.erase(counters.begin());
+    counters.emplace(counters.begin() + 10, std::in_place, -1);
+    ASSERT_EQ(0u, copy_counter::copies);
+    ASSERT_EQ(0u, copy_counter::moves);
+    ASSERT_EQ(1, counters.front().value().n);
+    ASSERT_EQ(-1, counters[10].value().n);
+    ASSERT_EQ(100u, counters.size());
+
+    using label = st::type<std::string, struct label_tag, st::equality_comparable>;
+
+    st::vector<label> names{label("a"), label("b"), label("c")};
+    names.insert(names.begin() + 1, label("a rather long name, to defeat the small string optimization"));
+    names.insert(names.begin(), names[2]);
+    names.erase(names.begin() + 3);
+    names.push_back(names.front());
+    names.resize(6);
+    const label long_label("a rather long name, to defeat the small string optimization");
+    ASSERT_EQ((st::vector<label>{label("b"), label("a"), long_label, label("c"), label("b"), label()}), names);
+
+    st::vector<label> copy(names);
+    names.clear();
+    names.shrink_to_fit();
+    ASSERT_EQ(0u, names.capacity());
+    names = std::move(copy);
+    ASSERT_EQ(6u, names.size());
+    ASSERT_THROW(names.at(6), std::out_of_range);
+}
+
+namespace
+{
+    template <typename AtomicT, typename U, typename = void>
+    struct has_fetch_add : std::false_type
+    {
+    };
+
+    template <typename AtomicT, typename U>
+    struct has_fetch_add<AtomicT, U,
+        std::void_t<decltype(std::declval<AtomicT &>().fetch_add(std::declval<U>()))>> : std::true_type
+    {
+    };
+
+    template <typename AtomicT, typename = void>
+    struct has_pre_increment : std::false_type
+    {
+    };
+
+    template <typename AtomicT>
+    struct has_pre_increment<AtomicT, std::void_t<decltype(++std::declval<AtomicT &>())>> : std::true_type
+    {
+    };
+
+    template <typename AtomicT, typename = void>
+    struct has_compare_exchange : std::false_type
+    {
+    };
+
+    template <typename AtomicT>
+    struct has_compare_exchange<AtomicT, std::void_t<decltype(std::declval<AtomicT &>().compare_exchange_strong(
+        std::declval<typename AtomicT::value_type &>(), std::declval<typename AtomicT::value_type>()))>> :
+        std::true_type
+    {
+    };
+}
+
+TEST(strong_type, atomic)
+{
+    using flags = st::type<unsigned int, struct flags_tag, st::bitwise_manipulable, st::equality_comparable>;
+
+    static_assert(st::atomic<integer>::is_always_lock_free);
+    static_assert(has_fetch_add<st::atomic<integer>, integer>::value);
+    static_assert(has_fetch_add<st::atomic<integer>, int>::value);
+    static_assert(!has_fetch_add<st::atomic<acceleration>, acceleration>::value);
+    static_assert(!has_fetch_add<st::atomic<speed>, int>::value);
+    static_assert(!has_fetch_add<st::atomic<flags>, flags>::value);
+    static_assert(has_pre_increment<st::atomic<integer>>::value);
+    static_assert(!has_pre_increment<st::atomic<speed>>::value);
+    static_assert(has_compare_exchange<st::atomic<flags>>::value);
+    static_assert(!has_compare_exchange<st::atomic<speed>>::value);
+
+    st::atomic<integer> counter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 10000; ++i) {
+                ++counter;
+                counter.fetch_add(integer(2), std::memory_order_relaxed);
+                counter += 1;
+                counter--;
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    ASSERT_EQ(integer(4 * 10000 * 3), counter.load());
+
+    ASSERT_EQ(integer(120000), counter.exchange(integer(5)));
+    ASSERT_EQ(integer(5), counter++);
+    ASSERT_EQ(integer(7), ++counter);
+    ASSERT_EQ(integer(10), counter += integer(3));
+    ASSERT_EQ(integer(10), counter.fetch_sub(integer(4), std::memory_order_acq_rel));
+    ASSERT_EQ(integer(2), counter -= integer(4));
+    counter.store(integer(std::numeric_limits<int>::max()));
+    ASSERT_EQ(integer(std::numeric_limits<int>::min()), counter += integer(1));
+    ASSERT_EQ(integer(std::numeric_limits<int>::max()), counter -= integer(1));
+    ASSERT_EQ(integer(std::numeric_limits<int>::max()), counter.load());
+
+    st::atomic<flags> bits(flags(0b0011u));
+    ASSERT_EQ(flags(0b0011u), bits.fetch_or(flags(0b0100u)));
+    ASSERT_EQ(flags(0b0101u), bits &= flags(0b1101u));
+    ASSERT_EQ(flags(0b0101u), bits.fetch_xor(flags(0b0001u), std::memory_order_relaxed));
+    ASSERT_EQ(flags(0b0100u), bits.load(std::memory_order_acquire));
+
+    flags expected(0b1111u);
+    ASSERT_FALSE(bits.compare_exchange_strong(expected, flags(0u)));
+    ASSERT_EQ(flags(0b0100u), expected);
+    while (!bits.compare_exchange_weak(expected, flags(0b1000u), std::memory_order_acq_rel, std::memory_order_acquire))
+        ;
+    ASSERT_EQ(flags(0b1000u), bits.load());
+}
+
+TEST(strong_type, sharded)
+{
+    using bytes = st::type<std::uint64_t, struct bytes_tag, st::addable, st::incrementable, st::equality_comparable>;
+
+    static_assert(has_pre_increment<st::sharded<bytes>>::value);
+    static_assert(!has_pre_increment<st::sharded<speed>>::value);
+
+    st::sharded<bytes> sent(3);
+    ASSERT_EQ(4u, sent.shard_count());
+    ASSERT_EQ(bytes(0), sent.load());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&sent]() {
+            for (int i = 0; i < 10000; ++i) {
+                sent += bytes(2);
+                ++sent;
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    ASSERT_EQ(bytes(8 * 10000 * 3), sent.load());
+
+    sent.reset();
+    ASSERT_EQ(bytes(0), sent.load());
+
+    st::sharded<integer> balance;
+    ASSERT_GE(balance.shard_count(), 1u);
+    balance += 5;
+    balance -= integer(7);
+    --balance;
+    ASSERT_EQ(integer(-3), balance.load());
+}
+
+TEST(strong_type, span_cast)
+{
+    using id = st::type<std::int64_t, struct id_tag, st::addable, st::equality_comparable>;
+
+    static_assert(st::is_layout_compatible_v<id>);
+    static_assert(st::is_layout_compatible_v<const integer>);
+    static_assert(st::is_layout_compatible_v<with_a_member>);
+    static_assert(!st::is_layout_compatible_v<int>);
+
+    static_assert(st::is_span_castable_v<std::int64_t, id>);
+    static_assert(st::is_span_castable_v<id, std::int64_t>);
+    static_assert(st::is_span_castable_v<id, const std::int64_t>);
+    static_assert(!st::is_span_castable_v<const id, std::int64_t>);
+    static_assert(!st::is_span_castable_v<std::uint64_t, id>);
+    static_assert(!st::is_span_castable_v<position, speed>);
+
+    std::vector<std::int64_t> column{1, 2, 3, 4};
+
+    st::span<id> ids = st::as_strong_span<id>(column);
+    ASSERT_EQ(column.data(), static_cast<void *>(ids.data()));
+    ASSERT_EQ(4u, ids.size());
+    ASSERT_EQ(id(3), ids[2]);
+
+    ids[0] = ids[1] + ids[2];
+    ASSERT_EQ(5, column[0]);
+
+    const std::vector<std::int64_t> &const_column = column;
+    st::span<const id> const_ids = st::as_strong_span<id>(const_column);
+    static_assert(std::is_same_v<decltype(const_ids), st::span<const id>>);
+    ASSERT_EQ(id(4), const_ids.back());
+
+    st::span<std::int64_t> raw = st::as_raw_span(ids);
+    ASSERT_EQ(column.data(), raw.data());
+
+    std::vector<id> strong_column{id(7), id(8)};
+    st::span<std::int64_t> raw_from_strong = st::as_raw_span(strong_column);
+    ASSERT_EQ(8, raw_from_strong[1]);
+
+    std::uint32_t buffer[3] = {10, 20, 30};
+    using offset = st::type<std::uint32_t, struct offset_tag>;
+    st::span<offset> offsets = st::as_strong_span<offset>(buffer + 1, 2);
+    ASSERT_EQ(30u, offsets[1].value());
+    ASSERT_EQ(2u, offsets.size());
+    ASSERT_EQ(1u, offsets.subspan(1).size());
+}
+
+template <typename V>
+static void check_batch_kernels()
+{
+    using quantity = st::type<V, struct quantity_tag, st::arithmetic, st::multiplicable_with<V>>;
+
+    std::vector<quantity> lhs, rhs;
+    for (int i = 0; i < 77; ++i) {
+        lhs.emplace_back(static_cast<V>((i * 7) % 23));
+        rhs.emplace_back(static_cast<V>((i * 5) % 11 + 1));
+    }
+
+    std::vector<quantity> out(lhs.size());
+
+    st::batch::add(lhs, rhs, out);
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+        ASSERT_EQ(lhs[i] + rhs[i], out[i]);
+
+    st::batch::sub(lhs, rhs, out);
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+        ASSERT_EQ(lhs[i] - rhs[i], out[i]);
+
+    st::batch::scale(lhs, static_cast<V>(3), out);
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+        ASSERT_EQ(lhs[i] * static_cast<V>(3), out[i]);
+
+    quantity expected_sum(static_cast<V>(1));
+    for (const auto &q : lhs)
+        expected_sum += q;
+    ASSERT_EQ(expected_sum, st::batch::sum(lhs, quantity(static_cast<V>(1))));
+
+    ASSERT_EQ(*std::min_element(rhs.begin(), rhs.end()), st::batch::min(rhs));
+    ASSERT_EQ(*std::max_element(lhs.begin(), lhs.end()), st::batch::max(lhs));
+    ASSERT_EQ(lhs[3], st::batch::min(st::span<const quantity>(lhs.data() + 3, 1)));
+
+    std::unique_ptr<bool[]> flags(new bool[lhs.size()]);
+    st::batch::less(lhs, rhs, st::span<bool>(flags.get(), lhs.size()));
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+        ASSERT_EQ(lhs[i] < rhs[i], flags[i]);
+
+    st::batch::equal(lhs, lhs, st::span<bool>(flags.get(), lhs.size()));
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+        ASSERT_TRUE(flags[i]);
+}
+
+TEST(strong_type, batch)
+{
+    check_batch_kernels<std::uint8_t>();
+    check_batch_kernels<std::int16_t>();
+    check_batch_kernels<std::int32_t>();
+    check_batch_kernels<std::uint32_t>();
+    check_batch_kernels<std::int64_t>();
+    check_batch_kernels<float>();
+    check_batch_kernels<double>();
+
+    using price = st::type<double, struct batch_price_tag, st::addable, st::multiplicable_with<int>>;
+
+    std::vector<price> prices{price(1.5), price(2.5), price(4.0)};
+    st::batch::scale(prices, 2, prices);
+    ASSERT_EQ(8.0, prices[2].value());
+    ASSERT_EQ(16.0, st::batch::sum(prices).value());
+}
+
+TEST(strong_type, parallel)
+{
+    using bytes = st::type<std::uint64_t, struct parallel_bytes_tag, st::addable, st::orderable, st::equality_comparable>;
+    using seconds = st::type<double, struct parallel_seconds_tag, st::addable, st::equality_comparable>;
+
+    st::parallel::thread_pool pool(4);
+    st::parallel::thread_pool single(1);
+    std::mt19937_64 rng(42);
+    std::vector<bytes> sizes;
+    std::vector<seconds> durations;
+
+    for (std::size_t i = 0; i < 1000003; ++i) {
+        sizes.emplace_back(rng() % 100000);
+        durations.emplace_back(static_cast<double>(rng() % 1000) / 7);
+    }
+
+    const auto expected_total = std::accumulate(sizes.begin(), sizes.end(), bytes(0));
+    ASSERT_EQ(expected_total, st::parallel::reduce(pool, sizes));
+    ASSERT_EQ(expected_total + bytes(5), st::parallel::reduce(pool, sizes, bytes(5)));
+    ASSERT_EQ(bytes(0), st::parallel::reduce(pool, std::vector<bytes>()));
+    ASSERT_EQ(*std::min_element(sizes.begin(), sizes.end()), st::parallel::min(pool, sizes));
+    ASSERT_EQ(*std::max_element(sizes.begin(), sizes.end()), st::parallel::max(pool, sizes));
+    ASSERT_EQ(bytes(3), st::parallel::max(pool, std::vector<bytes>{bytes(1), bytes(3), bytes(2)}));
+
+    /* Tasks only depend on the size of the range, so that floating point sums do not depend on the threads */
+    ASSERT_EQ(st::parallel::reduce(single, durations), st::parallel::reduce(pool, durations));
+
+    const auto to_seconds = [](const bytes &b) { return seconds(static_cast<double>(b.value()) / 1e6); };
+    ASSERT_EQ(st::parallel::transform_reduce(single, sizes, seconds(0), to_seconds),
+              st::parallel::transform_reduce(pool, sizes, seconds(0), to_seconds));
+    ASSERT_NEAR(static_cast<double>(expected_total.value()) / 1e6,
+                st::parallel::transform_reduce(pool, sizes, seconds(0), to_seconds).value(), 1e-3);
+
+    const auto bucket_of = [](const bytes &b) { return static_cast<std::size_t>(b.value() / 10000); };
+    std::vector<std::size_t> expected_counts(10);
+    for (const auto &b : sizes)
+        ++expected_counts[bucket_of(b)];
+    ASSERT_EQ(expected_counts, st::parallel::histogram(pool, sizes, 10, bucket_of));
+
+    std::vector<bytes> expected_sums(sizes.size());
+    std::partial_sum(sizes.begin(), sizes.end(), expected_sums.begin());
+    std::vector<bytes> sums(sizes.size());
+    st::parallel::prefix_sum(pool, sizes, sums);
+    ASSERT_EQ(expected_sums, sums);
+    st::parallel::prefix_sum(pool, sizes, sizes);
+    ASSERT_EQ(expected_sums, sizes);
+
+    const auto failing = [&expected_total](const bytes &b) {
+        if (b.value() > expected_total.value() / 2)
+            throw std::runtime_error("too large");
+        return seconds(0);
+    };
+    ASSERT_THROW(st::parallel::transform_reduce(pool, sizes, seconds(0), failing), std::runtime_error);
+
+    /* Operations started from a task run sequentially, and the pool keeps working afterwards */
+    std::vector<bytes> nested(64);
+    pool.run(nested.size(), [&](std::size_t task, std::size_t participant) {
+        ASSERT_LT(participant, pool.concurrency());
+        nested[task] = st::parallel::reduce(pool, std::vector<bytes>(100000, bytes(task)));
+    });
+    for (std::size_t task = 0; task < nested.size(); ++task)
+        ASSERT_EQ(bytes(100000 * task), nested[task]);
+    ASSERT_EQ(st::parallel::reduce(single, durations), st::parallel::reduce(pool, durations));
+}
+
+TEST(strong_type, optional)
+{
+    using node_id = st::type<std::uint32_t, struct optional_node_id_tag, st::has_sentinel<-1>, st::orderable,
+                             st::equality_comparable, st::hashable>;
+    using label = st::type<int, struct optional_label_tag, st::has_sentinel<0>>;
+    using maybe_node = st::optional<node_id>;
+
+    static_assert(sizeof(maybe_node) == sizeof(node_id));
+    static_assert(sizeof(std::optional<node_id>) == 2 * sizeof(node_id));
+    static_assert(std::is_trivially_copyable_v<maybe_node>);
+    static_assert(st::details::sentinel_value<node_id>() == 0xffffffffu);
+
+    /* Everything works in constant expressions */
+    static_assert(!maybe_node().has_value());
+    static_assert(maybe_node(node_id(3)).value() == node_id(3));
+    static_assert(maybe_node() < maybe_node(node_id(0)));
+    static_assert(maybe_node().value_or(node_id(7)) == node_id(7));
+    static_assert(st::unwrap(maybe_node()) == 0xffffffffu);
+    static_assert([] {
+        maybe_node n;
+        n.emplace(5u);
+        n.reset();
+        n = node_id(6);
+        return n.value().value();
+    }() == 6);
+
+    maybe_node n;
+    ASSERT_FALSE(n);
+    ASSERT_EQ(std::nullopt, n);
+    ASSERT_THROW(n.value(), std::bad_optional_access);
+    n = node_id(42);
+    ASSERT_TRUE(n.has_value());
+    ASSERT_EQ(node_id(42), n);
+    ASSERT_EQ(node_id(42), *n);
+    ASSERT_EQ(42u, n->value());
+    ASSERT_EQ(42u, st::unwrap(n));
+    ASSERT_NE(std::nullopt, n);
+    ASSERT_NE(maybe_node(), n);
+    ASSERT_LT(maybe_node(), n);
+    ASSERT_LT(n, maybe_node(node_id(43)));
+    ASSERT_EQ(std::hash<node_id>()(node_id(42)), std::hash<maybe_node>()(n));
+
+    maybe_node m(std::in_place, 7u);
+    swap(n, m);
+    ASSERT_EQ(node_id(7), n);
+    ASSERT_EQ(node_id(42), m);
+    m = std::nullopt;
+    ASSERT_EQ(maybe_node(), m);
+    ASSERT_EQ(0xffffffffu, st::unwrap(m));
+
+    /* Adjacency arrays keep the size of their raw counterpart, and hand the sentinel to raw code */
+    std::vector<maybe_node> parents(4);
+    parents[1] = node_id(0);
+    parents[3] = node_id(1);
+    ASSERT_EQ(4 * sizeof(std::uint32_t), parents.size() * sizeof(maybe_node));
+    ASSERT_EQ(2, std::count(parents.begin(), parents.end(), std::nullopt));
+
+    const st::optional<label> l = st::make_optional(label(9));
+    ASSERT_EQ(9, l->value());
+    ASSERT_EQ(0, st::unwrap(st::optional<label>()));
+}
+
+TEST(strong_type, transparent_lookup)
+{
+    using tenant = st::type<std::string, struct tenant_tag,
+        st::hashable, st::equality_comparable, st::orderable, st::lookupable_with<std::string_view>>;
+    using opaque = st::type<std::string, struct opaque_tag, st::hashable, st::lookupable_with<std::string_view>>;
+
+    static_assert(st::is_lookup_key_v<tenant, tenant>);
+    static_assert(st::is_lookup_key_v<tenant, std::string>);
+    static_assert(st::is_lookup_key_v<tenant, const std::string_view &>);
+    static_assert(!st::is_lookup_key_v<tenant, const char *>);
+    static_assert(!st::is_lookup_key_v<tenant, name>);
+    static_assert(std::is_invocable_v<st::equal_to<>, const tenant &, std::string_view>);
+    static_assert(std::is_invocable_v<st::equal_to<>, std::string_view, const tenant &>);
+    static_assert(!std::is_invocable_v<st::equal_to<>, const tenant &, const name &>);
+    static_assert(!std::is_invocable_v<st::hash<tenant>, const char *>);
+    static_assert(std::is_invocable_v<st::hash<>, const tenant &>);
+    static_assert(!std::is_invocable_v<st::hash<>, std::string_view>);
+    static_assert(!std::is_invocable_v<st::hash<>, std::string>);
+    static_assert(std::is_invocable_v<st::less<>, std::string_view, const tenant &>);
+    static_assert(std::is_invocable_v<st::hash<opaque>, std::string_view>);
+    static_assert(!std::is_invocable_v<st::equal_to<opaque>, const opaque &, std::string_view>);
+    static_assert(!std::is_invocable_v<st::equal_to<>, const opaque &, std::string_view>);
+    static_assert(!std::is_invocable_v<st::less<opaque>, const opaque &, const opaque &>);
+    static_assert(!std::is_invocable_v<st::less<>, std::string_view, const opaque &>);
+
+    const st::hash<tenant> hasher;
+    ASSERT_EQ(std::hash<tenant>()(tenant("acme")), hasher(tenant("acme")));
+    ASSERT_EQ(hasher(tenant("acme")), hasher(std::string_view("acme")));
+    ASSERT_EQ(hasher(tenant("acme")), hasher(std::string("acme")));
+    ASSERT_EQ(hasher(tenant("acme")), st::hash<>()(tenant("acme")));
+    ASSERT_TRUE(st::equal_to<>()(tenant("acme"), std::string_view("acme")));
+    ASSERT_TRUE(st::less<tenant>()(std::string_view("abc"), tenant("abd")));
+
+    using counted_key = st::type<counted_string, struct counted_key_tag,
+        st::orderable, st::lookupable_with<std::string_view>>;
+
+    std::map<counted_key, int, st::less<>> ordered;
+    ordered.emplace(counted_key("a rather long tenant name"), 1);
+    ordered.emplace(counted_key("another rather long tenant name"), 2);
+
+    allocation_counter::allocations = 0;
+    auto it = ordered.find(std::string_view("another rather long tenant name"));
+    ASSERT_EQ(0u, allocation_counter::allocations);
+    ASSERT_NE(ordered.end(), it);
+    ASSERT_EQ(2, it->second);
+
+    std::unordered_map<tenant, int, st::hash<tenant>, st::equal_to<tenant>> unordered;
+    unordered.emplace(tenant("acme"), 3);
+
+    /* What C++20 heterogeneous find() relies on: raw keys hash and compare like the keys of the map */
+    const auto &hash = unordered.hash_function();
+    const auto &key_eq = unordered.key_eq();
+    ASSERT_EQ(hash(unordered.begin()->first), hash(std::string_view("acme")));
+    ASSERT_TRUE(key_eq(unordered.begin()->first, std::string_view("acme")));
+    ASSERT_TRUE(key_eq(std::string_view("acme"), unordered.begin()->first));
+    ASSERT_FALSE(key_eq(unordered.begin()->first, std::string_view("initech")));
+#if defined(__cpp_lib_generic_unordered_lookup)
+    ASSERT_EQ(unordered.begin(), unordered.find(std::string_view("acme")));
+    ASSERT_EQ(unordered.end(), unordered.find(std::string_view("initech")));
+#endif
+}